@@ -116,11 +116,16 @@ void CLTBMode::perform()
  * <ol><li>read the batch file</li>
  * <li>load the common axioms and put them into a SInE selector</li>
  * <li>spawn child processes that try to prove a problem by calling
- *     CLTBProblem::searchForProof(). These processes are run sequentially and the time
- *     limit for each one is computed depending on the per-problem time limit,
- *     batch time limit, and time spent on this batch so far. The termination
- *     time for the proof search for a problem will be passed to
+ *     CLTBProblem::searchForProof(). Up to ltb_concurrent_problems of these
+ *     processes run at the same time, each of them using its share of the
+ *     available cores. The time limit for each one is computed depending on
+ *     the per-problem time limit, batch time limit, the time spent on this
+ *     batch so far and the number of problems that are not finished yet,
+ *     so time left unused by quickly solved problems goes to the remaining ones.
+ *     The termination time for the proof search for a problem will be passed to
  *     CLTBProblem::searchForProof() as an argument.</li></ol>
+ * The common axioms are parsed once in loadIncludes() and are shared by
+ * all problem processes, since these are forked from this one.
  * @author Andrei Voronkov
  * @since 04/06/2013 flight Manchester-Frankfurt
  */
@@ -141,78 +146,89 @@ void CLTBMode::solveBatch(istream& batchFile, bool first,vstring inputDirectory)
     doTraining();
   }
 
+  // split the cores between the problems that run concurrently
+  unsigned coreNumber = System::getNumberOfCores();
+  if (coreNumber < 1) {
+    coreNumber = 1;
+  }
+  unsigned concurrentProblems = env.options->ltbConcurrentProblems();
+  if (!concurrentProblems || concurrentProblems > coreNumber) {
+    concurrentProblems = coreNumber;
+  }
+  _coresPerProblem = coreNumber / concurrentProblems;
+  coutLineOutput() << "concurrent problems " << concurrentProblems
+                   << ", cores per problem " << _coresPerProblem << endl;
+
+  // maps the running problem processes to their problem and output files
+  DHMap<pid_t,StringPair> running;
+
   int solvedProblems = 0;
-  int remainingProblems = _problemFiles.size();
+  int unfinishedProblems = _problemFiles.size();
   StringPairStack::BottomFirstIterator probs(_problemFiles);
-  while (probs.hasNext()) {
-    StringPair res=probs.next();
-
-    vstring probFile= inputDirectory+"/"+res.first;
-    vstring outFile= res.second;
-    vstring outDir = env.options->ltbDirectory();
-    if(!outDir.empty()){
-      std::size_t found = outFile.find_last_of("/");
-      if(found != vstring::npos){
-        outFile = outFile.substr(found);
+  while (probs.hasNext() || running.size()) {
+    if (probs.hasNext() && running.size() < concurrentProblems) {
+      StringPair res=probs.next();
+
+      vstring probFile= inputDirectory+"/"+res.first;
+      vstring outFile= res.second;
+      vstring outDir = env.options->ltbDirectory();
+      if(!outDir.empty()){
+        std::size_t found = outFile.find_last_of("/");
+        if(found != vstring::npos){
+          outFile = outFile.substr(found);
+        }
+        outFile= outDir+"/"+outFile;
       }
-      outFile= outDir+"/"+outFile;
-    }
-
-    // calculate the next problem time limit in milliseconds
-    int elapsedTime = env.timer->elapsedMilliseconds();
-    int timeRemainingForThisBatch = terminationTime - elapsedTime;
-    coutLineOutput() << "time remaining for this batch " << timeRemainingForThisBatch << endl;
-    int remainingBatchTimeForThisProblem = timeRemainingForThisBatch / remainingProblems;
-    coutLineOutput() << "remaining batch time for this problem " << remainingBatchTimeForThisProblem << endl;
-    int nextProblemTimeLimit;
-    if (!_problemTimeLimit) {
-      nextProblemTimeLimit = remainingBatchTimeForThisProblem;
-    }
-    else if (remainingBatchTimeForThisProblem > _problemTimeLimit) {
-      nextProblemTimeLimit = _problemTimeLimit;
-    }
-    else {
-      nextProblemTimeLimit = remainingBatchTimeForThisProblem;
-    }
-    // time in milliseconds when the current problem should terminate
-    int problemTerminationTime = elapsedTime + nextProblemTimeLimit;
-    coutLineOutput() << "problem termination time " << problemTerminationTime << endl;
-
-    env.beginOutput();
-    env.out() << flush << "%" << endl;
-    lineOutput() << "SZS status Started for " << probFile << endl << flush;
-    env.endOutput();
 
-    pid_t child = Multiprocessing::instance()->fork();
-    if (!child) {
-      // child process
-      TIME_TRACE_NEW_ROOT("child process")
-      CLTBProblem prob(this, probFile, outFile);
-      try {
-        prob.searchForProof(problemTerminationTime,nextProblemTimeLimit,_category);
-      } catch (Exception& exc) {
-        cerr << "% Exception at proof search level" << endl;
-        exc.cry(cerr);
-        System::terminateImmediately(1); //we didn't find the proof, so we return nonzero status code
+      int nextProblemTimeLimit = nextProblemTime(terminationTime, unfinishedProblems, concurrentProblems);
+      // time in milliseconds when the current problem should terminate
+      int problemTerminationTime = env.timer->elapsedMilliseconds() + nextProblemTimeLimit;
+      coutLineOutput() << "problem termination time " << problemTerminationTime << endl;
+
+      env.beginOutput();
+      env.out() << flush << "%" << endl;
+      lineOutput() << "SZS status Started for " << probFile << endl << flush;
+      env.endOutput();
+
+      pid_t child = Multiprocessing::instance()->fork();
+      if (!child) {
+        // child process
+        TIME_TRACE_NEW_ROOT("child process")
+        CLTBProblem prob(this, probFile, outFile);
+        try {
+          prob.searchForProof(problemTerminationTime,nextProblemTimeLimit,_category);
+        } catch (Exception& exc) {
+          cerr << "% Exception at proof search level" << endl;
+          exc.cry(cerr);
+          System::terminateImmediately(1); //we didn't find the proof, so we return nonzero status code
+        }
+        // searchForProof() function should never return
+        ASSERTION_VIOLATION;
       }
-      // searchForProof() function should never return
-      ASSERTION_VIOLATION;
+
+      env.beginOutput();
+      lineOutput() << "solver pid " << child << endl;
+      env.endOutput();
+      ALWAYS(running.insert(child, make_pair(probFile, outFile)));
+      continue;
     }
 
-    env.beginOutput();
-    lineOutput() << "solver pid " << child << endl;
-    env.endOutput();
-    int resValue;
-    // wait until the child terminates
+    int resValue = 1;
+    pid_t finished = -1;
+    // wait until some child terminates
     try {
-      ALWAYS(
-        Multiprocessing::instance()->waitForChildTermination(resValue) == child
-      );
+      finished = Multiprocessing::instance()->waitForChildTermination(resValue);
     }
     catch(SystemFailException& ex) {
       cerr << "% SystemFailException at batch level" << endl;
       ex.cry(cerr);
     }
+    StringPair finishedFiles;
+    if (!running.pop(finished, finishedFiles)) {
+      // we don't know which problem this was, so we cannot report on it
+      continue;
+    }
+    vstring& probFile = finishedFiles.first;
 
     // output the result depending on the termination code
     env.beginOutput();
@@ -222,7 +238,7 @@ void CLTBMode::solveBatch(istream& batchFile, bool first,vstring inputDirectory)
 
       if (env.options->ltbLearning() != Options::LTBLearning::OFF){
         // As we solved it we can learn from the proof
-        learnFromSolutionFile(outFile);
+        learnFromSolutionFile(finishedFiles.second);
       }
     }
     else {
@@ -234,13 +250,40 @@ void CLTBMode::solveBatch(istream& batchFile, bool first,vstring inputDirectory)
 
     Timer::syncClock();
 
-    remainingProblems--;
+    unfinishedProblems--;
   }
   env.beginOutput();
   lineOutput() << "Solved " << solvedProblems << " out of " << _problemFiles.size() << endl;
   env.endOutput();
 } // CLTBMode::solveBatch(batchFile)
 
+/**
+ * Return the time limit in milliseconds for the next problem to be started.
+ *
+ * The time remaining for this batch is divided between the @b unfinishedProblems
+ * problems (both the running ones and the ones not started yet), of which
+ * @b concurrentProblems run at the same time. Since only unfinished problems
+ * are counted, the time not used by a problem solved early is automatically
+ * given to the remaining ones. The result never exceeds the per-problem time
+ * limit (if any) nor the time remaining for this batch.
+ */
+int CLTBMode::nextProblemTime(int terminationTime, int unfinishedProblems, unsigned concurrentProblems)
+{
+  CALL("CLTBMode::nextProblemTime");
+  ASS_G(unfinishedProblems,0);
+
+  int elapsedTime = env.timer->elapsedMilliseconds();
+  int timeRemainingForThisBatch = terminationTime - elapsedTime;
+  coutLineOutput() << "time remaining for this batch " << timeRemainingForThisBatch << endl;
+  int rounds = (unfinishedProblems + concurrentProblems - 1) / concurrentProblems;
+  int remainingBatchTimeForThisProblem = timeRemainingForThisBatch / rounds;
+  coutLineOutput() << "remaining batch time for this problem " << remainingBatchTimeForThisProblem << endl;
+  if (_problemTimeLimit && remainingBatchTimeForThisProblem > _problemTimeLimit) {
+    return _problemTimeLimit;
+  }
+  return remainingBatchTimeForThisProblem;
+} // CLTBMode::nextProblemTime
+
 void CLTBMode::loadIncludes()
 {
   CALL("CLTBMode::loadIncludes");
@@ -277,6 +320,12 @@ void CLTBMode::loadIncludes()
   //ensure we scan the theory axioms for property here, so we don't need to
   //do it afterward in each problem
   _baseProblem->getProperty();
+
+  if (env.options->ltbSharedSine()) {
+    // the D-relation is computed once here and inherited by all the problem processes
+    _theorySelector = new SineTheorySelector(*env.options);
+    _theorySelector->initSelectionStructure(theoryAxioms);
+  }
   env.statistics->phase=Statistics::UNKNOWN_PHASE;
 } // CLTBMode::loadIncludes
 
@@ -577,7 +626,7 @@ vstring CLTBProblem::problemFinishedString = "##Problem finished##vn;3-d-ca-12=1
 
 CLTBProblem::CLTBProblem(CLTBMode* parent, vstring problemFile, vstring outFile)
   : parent(parent), problemFile(problemFile), outFile(outFile),
-    prb(*parent->_baseProblem), _syncSemaphore(1)
+    prb(*parent->_baseProblem), problemUnits(0), _syncSemaphore(1)
 {
   //add the privileges into the semaphore
   _syncSemaphore.set(0,1);
@@ -710,6 +759,7 @@ void CLTBProblem::searchForProof(int terminationTime,int timeLimit,const Categor
     parser.parse();
     UnitList* probUnits = parser.units();
     UIHelper::setConjecturePresence(parser.containsConjecture());
+    problemUnits = UnitList::copy(probUnits);
     prb.addUnits(probUnits);
 
     env.options->setOutputAxiomNames(outputAxiomValue);
@@ -782,7 +832,7 @@ bool CLTBProblem::runSchedule(Schedule& schedule,StrategySet& used,int terminati
   // compute the number of parallel processes depending on the
   // number of available cores
   int parallelProcesses;
-  unsigned coreNumber = System::getNumberOfCores();
+  unsigned coreNumber = parent->_coresPerProblem;
   if (coreNumber <= 1) {
     parallelProcesses = 1;
   }
@@ -962,23 +1012,28 @@ void CLTBProblem::runSlice(Options& strategyOpt)
   opt.setProblemName(problemFile);
   *env.options = opt; //just temporarily until we get rid of dependencies on env.options in solving
 
-//  if (env.options->sineSelection()!=Options::SS_OFF) {
-//    //add selected axioms from the theory
-//    parent->theorySelector.perform(probUnits);
-//
-//    env.options->setSineSelection(Options::SS_OFF);
-//    env.options->forceIncompleteness();
-//  }
-//  else {
-//    //if there wasn't any sine selection, just put in all theory axioms
-//    probUnits=UnitList::concat(probUnits, parent->theoryAxioms);
-//  }
-
   env.beginOutput();
   CLTBMode::lineOutput() << opt.testId() << " on " << opt.problemName() << endl;
   env.endOutput();
 
-  ProvingHelper::runVampire(prb, opt);
+  if (parent->_theorySelector && opt.sineSelection()!=Options::SineSelection::OFF
+      && parent->_theorySelector->canSelectFor(opt)) {
+    // select the theory axioms using the shared D-relation, so that
+    // the slice only has to process the problem-specific units
+    UnitList* units = UnitList::copy(problemUnits);
+    parent->_theorySelector->perform(units);
+
+    Problem selected(units);
+    if (UnitList::length(units) < UnitList::length(prb.units())) {
+      selected.reportIncompleteTransformation();
+    }
+    opt.setSineSelection(Options::SineSelection::OFF);
+    *env.options = opt;
+    ProvingHelper::runVampire(selected, opt);
+  }
+  else {
+    ProvingHelper::runVampire(prb, opt);
+  }
 
   //set return value to zero if we were successful
   if (env.statistics->terminationReason == Statistics::REFUTATION) {
@@ -19,6 +19,7 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHMap.hpp"
 #include "Lib/DHSet.hpp"
 #include "Lib/Portability.hpp"
 #include "Lib/ScopedPtr.hpp"
@@ -58,6 +59,7 @@ public:
 private:
   void solveBatch(istream& batchFile, bool first,vstring inputDirectory);
   int readInput(istream& batchFile, bool first);
+  int nextProblemTime(int terminationTime, int unfinishedProblems, unsigned concurrentProblems);
   static ostream& lineOutput();
   static ostream& coutLineOutput();
   void loadIncludes();
@@ -91,6 +93,8 @@ private:
   bool _questionAnswering;
   /** total time used by batches before this one, in milliseconds */
   int _timeUsedByPreviousBatches;
+  /** number of cores each of the concurrently solved problems may use */
+  unsigned _coresPerProblem;
 
   /** files to be included */
   StringList* _theoryIncludes;
@@ -102,6 +106,13 @@ private:
 
   ScopedPtr<Problem> _baseProblem;
 
+  /**
+   * SInE D-relation over the included axioms, built once in loadIncludes()
+   * if ltb_shared_sine is on. Slices select the theory axioms from it
+   * instead of running SInE over the whole problem.
+   */
+  ScopedPtr<Shell::SineTheorySelector> _theorySelector;
+
   // This contains formulas 'learned' in the sense that they were input
   // formulas used in proofs of previous problems
   // Note: this relies on the assurance that formulas are consistently named
@@ -156,6 +167,9 @@ private:
    */
   Problem& prb;
 
+  /** the units read from the problem file (as opposed to the included axioms) */
+  UnitList* problemUnits;
+
   Semaphore _syncSemaphore; // semaphore for synchronizing writing if the solution
 
   /**
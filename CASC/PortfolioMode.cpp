@@ -16,6 +16,7 @@
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Portability.hpp"
+#include "Lib/Random.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/System.hpp"
 #include "Lib/ScopedLet.hpp"
@@ -27,11 +28,17 @@
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 #include "Shell/Normalisation.hpp"
+#include "Shell/Preprocess.hpp"
 #include "Shell/Shuffling.hpp"
 #include "Shell/TheoryFinder.hpp"
 
 #include <unistd.h>
 #include <signal.h>
+#include <cerrno>
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/wait.h>
+#endif
 #include <fstream>
 #include <stdio.h>
 #include <cstdio>
@@ -48,7 +55,7 @@
 using namespace Lib;
 using namespace CASC;
 
-PortfolioMode::PortfolioMode() : _slowness(1.0), _syncSemaphore(2) {
+PortfolioMode::PortfolioMode() : _preprocessed(false), _preprocessingTime(0), _zygoteRequests(0), _slowness(1.0), _syncSemaphore(2) {
   unsigned cores = System::getNumberOfCores();
   cores = cores < 1 ? 1 : cores;
   _numWorkers = min(cores, env.options->multicore());
@@ -120,6 +127,7 @@ bool PortfolioMode::perform(float slowness)
     if (env.options && env.options->timeStatistics()) {
       TimeTrace::instance().printPretty(env.out());
     }
+    TimeTrace::instance().outputToFile();
 #endif // VTIME_PROFILING
     env.endOutput();
   }
@@ -137,7 +145,10 @@ bool PortfolioMode::searchForProof()
    * 1) getProperty, 2) normalise, 3) TheoryFinder::search
    * is the same as in profileMode (vampire.cpp)
    * also, cf. the beginning of Preprocessing::preprocess*/
-  Shell::Property* property = _prb->getProperty();
+  // unless the units get changed in between, looking for theory axioms
+  // is done in the same pass over the problem as computing its property
+  bool theoriesWithProperty = !env.options->normalize() && !env.options->shuffleInput();
+  Shell::Property* property = theoriesWithProperty ? _prb->getPropertyAndTheories() : _prb->getProperty();
   {
     TIME_TRACE(TimeTrace::PREPROCESSING);
 
@@ -155,7 +166,7 @@ bool PortfolioMode::searchForProof()
     } 
 
     //TheoryFinder cannot cope with polymorphic input
-    if(!env.property->hasPolymorphicSym()){
+    if(!theoriesWithProperty && !env.property->hasPolymorphicSym()){
       TheoryFinder(_prb->units(),property).search();
     }
   }
@@ -426,7 +437,7 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
   while(Timer::syncClock(), remainingTime = env.remainingTime() / 100, remainingTime > 0)
   {
     // running under capacity, wake up more tasks
-    while(processes.size() < _numWorkers)
+    while(processes.size() + _zygoteRequests < _numWorkers)
     {
       // after exhaustion we replace the schedule
       // by copies with x2 time limits and do this forever
@@ -439,15 +450,7 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
       ALWAYS(it.hasNext());
 
       vstring code = it.next();
-      pid_t process = Multiprocessing::instance()->fork();
-      ASS_NEQ(process, -1);
-      if(process == 0)
-      {
-        TIME_TRACE_NEW_ROOT("child process")
-        runSlice(code, remainingTime);
-        ASSERTION_VIOLATION; // should not return
-      }
-      ALWAYS(processes.insert(process));
+      startSlice(code, remainingTime, processes);
     }
 
     bool exited, signalled;
@@ -455,6 +458,17 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
     // sleep until process changes state
     pid_t process = Multiprocessing::instance()->poll_children(exited, signalled, code);
 
+#ifdef __linux__
+    // a worker reports its pid before it starts, so any worker seen here is known after this
+    collectZygoteWorkers(processes);
+
+    if((exited || signalled) && _zygotePids.contains(process)) {
+      // the slices of this zygote will be run the usual way from now on
+      retireZygote(process, processes);
+      continue;
+    }
+#endif
+
     /*
     cout << "Child " << process
         << " exit " << exited
@@ -480,6 +494,11 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
     }
   }
 
+#ifdef __linux__
+  // this also collects the workers the zygotes have started meanwhile
+  stopZygotes(processes);
+#endif
+
   // kill all running processes first
   decltype(processes)::Iterator killIt(processes);
   while(killIt.hasNext())
@@ -488,6 +507,343 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
   return success;
 }
 
+/**
+ * Start a worker process running the slice @b sliceCode and add its pid
+ * to @b processes, or leave starting it to a zygote.
+ */
+void PortfolioMode::startSlice(const vstring& sliceCode, int remainingTime, Set<pid_t>& processes)
+{
+  CALL("PortfolioMode::startSlice");
+
+#ifdef __linux__
+  if(env.options->preprocessingZygotes() && startSliceInZygote(sliceCode)) {
+    return;
+  }
+#endif
+
+  pid_t process = Multiprocessing::instance()->fork();
+  ASS_NEQ(process, -1);
+  if(process == 0)
+  {
+    TIME_TRACE_NEW_ROOT("child process")
+    runSlice(sliceCode, remainingTime);
+    ASSERTION_VIOLATION; // should not return
+  }
+  ALWAYS(processes.insert(process));
+}
+
+#ifdef __linux__
+
+namespace {
+
+/**
+ * Send @b len bytes from @b buf over the socket @b fd.
+ * Return false if the other side is gone.
+ */
+bool sendAll(int fd, const void* buf, size_t len)
+{
+  const char* ptr = static_cast<const char*>(buf);
+  while(len) {
+    ssize_t sent = send(fd, ptr, len, MSG_NOSIGNAL);
+    if(sent == -1 && errno == EINTR) {
+      continue;
+    }
+    if(sent <= 0) {
+      return false;
+    }
+    ptr += sent;
+    len -= sent;
+  }
+  return true;
+}
+
+/**
+ * Receive exactly @b len bytes into @b buf from the socket @b fd.
+ * Return false if the other side is gone.
+ */
+bool receiveAll(int fd, void* buf, size_t len)
+{
+  char* ptr = static_cast<char*>(buf);
+  while(len) {
+    ssize_t received = read(fd, ptr, len);
+    if(received == -1 && errno == EINTR) {
+      continue;
+    }
+    if(received <= 0) {
+      return false;
+    }
+    ptr += received;
+    len -= received;
+  }
+  return true;
+}
+
+}
+
+/**
+ * Send the slice @b sliceCode to the zygote of the slices that preprocess
+ * the problem in the same way, creating the zygote first if there is none yet.
+ *
+ * Return false if the slice has to be run the usual way. The zygote starts
+ * the worker once it has finished preprocessing, and the worker reports its
+ * pid over the zygote's channel (see collectZygoteWorkers).
+ */
+bool PortfolioMode::startSliceInZygote(const vstring& sliceCode)
+{
+  CALL("PortfolioMode::startSliceInZygote");
+
+  vstring key;
+  try {
+    Options opt = *env.options;
+    opt.readFromEncodedOptions(sliceCode);
+    key = opt.preprocessingKey();
+  }
+  catch(Exception&) {
+    // the worker will complain about the slice
+    return false;
+  }
+
+  Zygote* zygote;
+  if(_zygotes.getValuePtr(key, zygote)) {
+    zygote->pid = -1;
+    zygote->channel = -1;
+    zygote->started = 0;
+
+    int channel[2];
+    if(socketpair(AF_UNIX, SOCK_STREAM, 0, channel)) {
+      return false;
+    }
+    pid_t pid = Multiprocessing::instance()->fork();
+    ASS_NEQ(pid, -1);
+    if(pid == 0)
+    {
+      close(channel[0]);
+      TIME_TRACE_NEW_ROOT("zygote process")
+      runZygote(sliceCode, channel[1]);
+      ASSERTION_VIOLATION; // should not return
+    }
+    close(channel[1]);
+    zygote->pid = pid;
+    zygote->channel = channel[0];
+    ALWAYS(_zygotePids.insert(pid));
+  }
+  if(zygote->channel == -1) {
+    // the zygote is gone, most likely it failed in preprocessing
+    return false;
+  }
+
+  unsigned length = sliceCode.size();
+  if(!sendAll(zygote->channel, &length, sizeof(length)) ||
+     !sendAll(zygote->channel, sliceCode.c_str(), length)) {
+    // the zygote has terminated, retireZygote will take care of its slices
+    return false;
+  }
+  zygote->requested.push(sliceCode);
+  _zygoteRequests++;
+  return true;
+}
+
+/**
+ * Preprocess the problem under the options of @b sliceCode and then fork
+ * a worker for every slice received over @b channel, until the parent
+ * closes it.
+ *
+ * The workers are forked as siblings of the zygote, so that the parent waits
+ * for them the same way as for the workers it forks itself, and they die
+ * together with the parent. Each worker sends its pid over @b channel before
+ * it does anything else.
+ */
+void PortfolioMode::runZygote(const vstring& sliceCode, int channel)
+{
+  CALL("PortfolioMode::runZygote");
+
+  System::registerForSIGHUPOnParentDeath();
+  UIHelper::portfolioParent=false;
+
+  // the channels of the other zygotes are of no use here
+  decltype(_zygotes)::Iterator zit(_zygotes);
+  while(zit.hasNext()) {
+    vstring key;
+    Zygote& other = zit.nextRef(key);
+    if(other.channel != -1) {
+      close(other.channel);
+    }
+  }
+
+  try {
+    // the workers read their options on top of the original ones
+    Options original = *env.options;
+
+    Options opt = original;
+    opt.readFromEncodedOptions(sliceCode);
+    opt.setNormalize(false);
+    opt.setForcedOptionValues();
+    opt.checkGlobalOptionConstraints();
+    *env.options = opt;
+
+    Lib::Random::setSeed(opt.randomSeed());
+    Timer::syncClock();
+    int preprocessingStart = env.timer->elapsedMilliseconds();
+    {
+      TIME_TRACE(TimeTrace::PREPROCESSING);
+      Preprocess(opt).preprocess(*_prb);
+    }
+    Timer::syncClock();
+    _preprocessingTime = (env.timer->elapsedMilliseconds() - preprocessingStart) / 100;
+
+    *env.options = original;
+  }
+  catch(Exception&) {
+    // the slices will report the problem when run the usual way
+    System::terminateImmediately(1);
+  }
+
+  unsigned length;
+  while(receiveAll(channel, &length, sizeof(length))) {
+    vstring code(length, ' ');
+    if(!receiveAll(channel, &code[0], length)) {
+      break;
+    }
+
+    // the time limit is shared with the parent, whose request may have waited for the preprocessing
+    Timer::syncClock();
+    int remainingTime = env.remainingTime() / 100;
+    if(remainingTime <= 0) {
+      break;
+    }
+
+    pid_t worker = Multiprocessing::instance()->forkSibling();
+    if(worker == 0)
+    {
+      pid_t self = getpid();
+      sendAll(channel, &self, sizeof(self));
+      close(channel);
+      _preprocessed = true;
+      TIME_TRACE_NEW_ROOT("child process")
+      runSlice(code, remainingTime);
+      ASSERTION_VIOLATION; // should not return
+    }
+  }
+  System::terminateImmediately(0);
+} // runZygote
+
+/**
+ * Add to @b processes the pid of the next worker of @b zygote. Unless @b wait is set,
+ * do so only if the worker has reported already.
+ *
+ * Return false if there was no pid to receive.
+ */
+bool PortfolioMode::receiveZygoteWorker(Zygote& zygote, Set<pid_t>& processes, bool wait)
+{
+  CALL("PortfolioMode::receiveZygoteWorker");
+
+  pid_t worker;
+  if(!wait && recv(zygote.channel, &worker, sizeof(worker), MSG_PEEK | MSG_DONTWAIT) != sizeof(worker)) {
+    return false;
+  }
+  if(!receiveAll(zygote.channel, &worker, sizeof(worker))) {
+    return false;
+  }
+  ALWAYS(processes.insert(worker));
+
+  ASS_L(zygote.started, zygote.requested.size());
+  _zygoteRequests--;
+  if(++zygote.started == zygote.requested.size()) {
+    zygote.requested.reset();
+    zygote.started = 0;
+  }
+  return true;
+}
+
+/**
+ * Add to @b processes the pids of the workers that have reported over the
+ * channels of the zygotes, without waiting for any.
+ */
+void PortfolioMode::collectZygoteWorkers(Set<pid_t>& processes)
+{
+  CALL("PortfolioMode::collectZygoteWorkers");
+
+  decltype(_zygotes)::Iterator zit(_zygotes);
+  while(zit.hasNext()) {
+    vstring key;
+    Zygote& z = zit.nextRef(key);
+    if(z.channel != -1) {
+      while(receiveZygoteWorker(z, processes, false)) {}
+    }
+  }
+}
+
+/**
+ * Collect the workers of the zygote @b zygote, which has terminated, into
+ * @b processes, and start the slices it did not get to the usual way.
+ */
+void PortfolioMode::retireZygote(pid_t zygote, Set<pid_t>& processes)
+{
+  CALL("PortfolioMode::retireZygote");
+
+  ALWAYS(_zygotePids.remove(zygote));
+
+  Stack<vstring> notStarted;
+  decltype(_zygotes)::Iterator zit(_zygotes);
+  while(zit.hasNext()) {
+    vstring key;
+    Zygote& z = zit.nextRef(key);
+    if(z.pid == zygote && z.channel != -1) {
+      // the channel is at its end once all the workers have reported
+      while(receiveZygoteWorker(z, processes, true)) {}
+      close(z.channel);
+      z.channel = -1;
+
+      for(unsigned i = z.started; i < z.requested.size(); i++) {
+        notStarted.push(z.requested[i]);
+      }
+      _zygoteRequests -= z.requested.size() - z.started;
+      z.requested.reset();
+      z.started = 0;
+    }
+  }
+
+  Timer::syncClock();
+  int remainingTime = env.remainingTime() / 100;
+  Stack<vstring>::BottomFirstIterator sit(notStarted);
+  while(sit.hasNext() && remainingTime > 0) {
+    startSlice(sit.next(), remainingTime, processes);
+  }
+}
+
+/**
+ * Kill all zygotes and wait for them, so that they do not show up
+ * among the workers of a later schedule. The workers they started
+ * are added to @b processes.
+ */
+void PortfolioMode::stopZygotes(Set<pid_t>& processes)
+{
+  CALL("PortfolioMode::stopZygotes");
+
+  decltype(_zygotePids)::Iterator pit(_zygotePids);
+  while(pit.hasNext()) {
+    pid_t zygote = pit.next();
+    Multiprocessing::instance()->killNoCheck(zygote, SIGKILL);
+    waitpid(zygote, nullptr, 0);
+  }
+  _zygotePids.reset();
+
+  decltype(_zygotes)::Iterator zit(_zygotes);
+  while(zit.hasNext()) {
+    vstring key;
+    Zygote& z = zit.nextRef(key);
+    if(z.channel != -1) {
+      // the workers forked before the zygote was killed still report
+      while(receiveZygoteWorker(z, processes, true)) {}
+      close(z.channel);
+    }
+  }
+  _zygotes.reset();
+  _zygoteRequests = 0;
+}
+
+#endif // __linux__
+
 /**
  * Run a schedule.
  * Return true if a proof was found, otherwise return false.
@@ -589,6 +945,10 @@ void PortfolioMode::runSlice(vstring sliceCode, int timeLimitInDeciseconds)
   TIME_TRACE("run slice");
 
   int sliceTime = getSliceTime(sliceCode);
+  if (sliceTime && _preprocessed) {
+    // the preprocessing done by the zygote counts against the slice, as if the slice did it itself
+    sliceTime = max(sliceTime - _preprocessingTime, 1);
+  }
   if (sliceTime > timeLimitInDeciseconds 
     || !sliceTime) // no limit set, i.e. "infinity"
   {
@@ -641,6 +1001,7 @@ void PortfolioMode::runSlice(Options& strategyOpt)
   env.timer->start();
 
   Timer::resetInstructionMeasuring();
+  Timer::resetHardwareCounters();
   Timer::setLimitEnforcement(true);
 
   Options opt = strategyOpt;
@@ -661,7 +1022,12 @@ void PortfolioMode::runSlice(Options& strategyOpt)
     env.endOutput();
   }
 
-  Saturation::ProvingHelper::runVampire(*_prb, opt);
+  if (_preprocessed) {
+    // forked from a zygote, which has already preprocessed the problem
+    Saturation::ProvingHelper::runVampireSaturation(*_prb, opt);
+  } else {
+    Saturation::ProvingHelper::runVampire(*_prb, opt);
+  }
 
   //set return value to zero if we were successful
   if (env.statistics->terminationReason == Statistics::REFUTATION ||
@@ -17,7 +17,10 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
 #include "Lib/ScopedPtr.hpp"
+#include "Lib/Set.hpp"
 #include "Lib/Stack.hpp"
 
 #include "Lib/VString.hpp"
@@ -54,9 +57,47 @@ private:
 
   bool runSchedule(Schedule schedule);
   bool runScheduleAndRecoverProof(Schedule schedule);
+  void startSlice(const vstring& sliceCode, int remainingTime, Set<pid_t>& processes);
   [[noreturn]] void runSlice(vstring sliceCode, int remainingTime);
   [[noreturn]] void runSlice(Options& strategyOpt);
 
+#ifdef __linux__
+  bool startSliceInZygote(const vstring& sliceCode);
+  [[noreturn]] void runZygote(const vstring& sliceCode, int channel);
+  void collectZygoteWorkers(Set<pid_t>& processes);
+  void retireZygote(pid_t zygote, Set<pid_t>& processes);
+  void stopZygotes(Set<pid_t>& processes);
+
+  /**
+   * A process that has preprocessed the problem for a group of slices
+   * and forks the workers of these slices on request.
+   */
+  struct Zygote {
+    pid_t pid;
+    /**
+     * Socket over which the zygote receives the slices to run and its workers
+     * report their pids, -1 once the zygote is gone
+     */
+    int channel;
+    /** slices sent to the zygote, the first @b started of which have a worker */
+    Stack<vstring> requested;
+    unsigned started;
+  };
+
+  bool receiveZygoteWorker(Zygote& zygote, Set<pid_t>& processes, bool wait);
+
+  /** zygotes indexed by the preprocessing key of the slices they serve */
+  DHMap<vstring, Zygote> _zygotes;
+  DHSet<pid_t> _zygotePids;
+#endif
+
+  /** true in workers forked from a zygote, where the problem is already preprocessed */
+  bool _preprocessed;
+  /** in workers forked from a zygote, the time the zygote took to preprocess, in deciseconds */
+  int _preprocessingTime;
+  /** number of slices sent to zygotes whose workers have not reported yet */
+  unsigned _zygoteRequests;
+
 #if VDEBUG
   DHSet<pid_t> childIds;
 #endif
@@ -13,6 +13,13 @@
 #include "Debug/TimeProfiling.hpp"
 #include <iomanip>
 #include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "Lib/Environment.hpp"
+#include "Lib/System.hpp"
 #include "Shell/Options.hpp"
 
 namespace Shell {
@@ -37,7 +44,10 @@ const char* const TimeTrace::TERM_SHARING;
 TimeTrace::TimeTrace() 
   : _root("[root]")
   , _stack({ {&_root, Clock::now(), }, }) 
+  , _current(&_root)
+  , _epoch(get<1>(_stack.top()))
   , _enabled(false)
+  , _sampling(Duration::zero())
 {  }
 
 TimeTrace::ScopedTimer::ScopedTimer(const char* name)
@@ -60,12 +70,13 @@ TimeTrace::ScopedTimer::ScopedTimer(TimeTrace& trace, const char* name)
           children.push(Lib::make_unique<Node>(name));
           return &*children.top();
       });
-    auto start = Clock::now();
+    auto start = _trace._sampling == Duration::zero() ? Clock::now() : TimePoint();
 #if VDEBUG
     _start = start;
 #endif 
 
     _trace._stack.push(std::make_pair(node, start));
+    _trace._current = node;
   }
 }
 
@@ -74,14 +85,61 @@ TimeTrace TimeTrace::_instance;
 void TimeTrace::setEnabled(bool v) 
 { _enabled = v; }
 
+/**
+ * Switch from reading the clock in every traced block to sampling the innermost open block
+ * every @b intervalInMicroseconds of cpu time. Zero switches sampling off.
+ */
+void TimeTrace::setSampling(unsigned intervalInMicroseconds)
+{
+  _sampling = std::chrono::microseconds(intervalInMicroseconds);
+  if (_enabled && intervalInMicroseconds) {
+    startSampling();
+  }
+}
+
+void TimeTrace::sampleHandler(int)
+{
+  Node* node = _instance._current;
+  node->samples++;
+}
+
+/**
+ * Arm the profiling timer. Interval timers are not inherited by forked processes, so this is
+ * also done whenever a child process sets its own root.
+ */
+void TimeTrace::startSampling()
+{
+  struct sigaction act;
+  memset(&act, 0, sizeof(act));
+  act.sa_handler = sampleHandler;
+  // the timer must not make the blocking calls of the portfolio parent fail
+  act.sa_flags = SA_RESTART;
+  sigemptyset(&act.sa_mask);
+  sigaction(SIGPROF, &act, nullptr);
+
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(_sampling).count();
+  itimerval tv;
+  tv.it_interval.tv_sec = us / 1000000;
+  tv.it_interval.tv_usec = us % 1000000;
+  tv.it_value = tv.it_interval;
+  if (setitimer(ITIMER_PROF, &tv, nullptr) != 0) {
+    SYSTEM_FAIL("Call to setitimer failed when starting time trace sampling.", errno);
+  }
+}
+
 TimeTrace::ScopedTimer::~ScopedTimer()
 {
   if (_trace._enabled) {
-    auto now = Clock::now();
     auto cur = _trace._stack.pop();
+    _trace._current = get<0>(_trace._stack.top());
     auto node = get<0>(cur);
     auto start = get<1>(cur);
-    node->measurements.add(now  - start);
+    if (_trace._sampling == Duration::zero()) {
+      node->measurements.add(Clock::now() - start);
+    } else {
+      // the duration is computed from the samples when the trace is output
+      node->measurements.add(Duration::zero());
+    }
     ASS_EQ(node->name, _name);
     ASS(start == _start);
   }
@@ -96,7 +154,10 @@ TimeTrace::ScopedChangeRoot::ScopedChangeRoot(TimeTrace& trace)
   : _trace(trace)
 {
   if (_trace._enabled) {
-    _trace._tmpRoots.push(get<0>(trace._stack.top()));
+    _trace._tmpRoots.push(std::make_tuple(get<0>(trace._stack.top()), Clock::now()));
+    if (_trace._sampling != Duration::zero()) {
+      _trace.startSampling();
+    }
   }
 }
 
@@ -109,6 +170,31 @@ TimeTrace::ScopedChangeRoot::~ScopedChangeRoot()
 
 TimeTrace::Duration TimeTrace::Node::totalDuration() const
 { return measurements.sum(); }
+
+/** the time spent in this node but not in any of its children */
+TimeTrace::Duration TimeTrace::Node::selfDuration() const
+{
+  auto self = totalDuration();
+  for (auto& c : children) {
+    self -= c->totalDuration();
+  }
+  // the clock is read at slightly different points for parent and children
+  return std::max(self, Duration::zero());
+}
+
+/**
+ * Sets the durations of this subtree to the ones estimated from the samples taken with
+ * the given @b interval, and returns the duration of this node.
+ */
+TimeTrace::Duration TimeTrace::Node::applySamples(Duration interval)
+{
+  auto total = samples * interval;
+  for (auto& c : children) {
+    total += c->applySamples(interval);
+  }
+  measurements.setSum(total);
+  return total;
+}
   
 std::ostream& operator<<(std::ostream& out, TimeTrace::Duration const& self)
 { 
@@ -252,17 +338,39 @@ void TimeTrace::Node::flatten_(FlattenState& s)
   }
 }
 
-void TimeTrace::printPretty(std::ostream& out)
+/**
+ * Makes the measurements include the blocks that are still open, and returns the root to be
+ * output. Must be matched by a call to endOutput with the same time point.
+ */
+TimeTrace::Node& TimeTrace::beginOutput(TimePoint now)
 {
+  auto sampling = _sampling != Duration::zero();
+  for (auto& x : _stack) {
+    auto node = get<0>(x);
+    auto start = get<1>(x);
+    node->measurements.add(sampling ? Duration::zero() : now - start);
+  }
+  if (sampling) {
+    _root.applySamples(_sampling);
+  }
+  return _tmpRoots.size() == 0 ? _root : *get<0>(_tmpRoots.top());
+}
 
-  auto now = Clock::now();
+void TimeTrace::endOutput(TimePoint now)
+{
+  auto sampling = _sampling != Duration::zero();
   for (auto& x : _stack) {
     auto node = get<0>(x);
     auto start = get<1>(x);
-    node->measurements.add(now - start);
+    node->measurements.remove(sampling ? Duration::zero() : now - start);
   }
+}
 
-  auto& root = _tmpRoots.size() == 0 ? _root : *_tmpRoots.top();
+void TimeTrace::printPretty(std::ostream& out)
+{
+
+  auto now = Clock::now();
+  auto& root = beginOutput(now);
   Stack<const char*> indent;
   auto rootOpts = Node::NodeFormatOpts::root(indent);
 
@@ -278,11 +386,116 @@ void TimeTrace::printPretty(std::ostream& out)
   root.flatten().printPrettyRec(out, rootOpts);
   out << "===== end of flattened time profile =====" << std::endl;
 
+  endOutput(now);
+}
 
-  for (auto& x : _stack) {
-    auto node = get<0>(x);
-    auto start = get<1>(x);
-    node->measurements.remove(now - start);
+/**
+ * Writes one line "root;child;...;node <self time in μs>" per node, which is the input format of
+ * flamegraph.pl. Lines with the same path coming from different processes are summed up by
+ * the viewers, which merges the traces of all the slices of a portfolio run.
+ */
+void TimeTrace::Node::outputCollapsed(std::ostream& out, Stack<const char*>& path)
+{
+  path.push(name);
+  auto self = std::chrono::duration_cast<std::chrono::microseconds>(selfDuration()).count();
+  if (self > 0) {
+    for (unsigned i = 0; i < path.size(); i++) {
+      out << (i == 0 ? "" : ";") << path[i];
+    }
+    out << " " << self << "\n";
+  }
+  for (auto& c : children) {
+    c->outputCollapsed(out, path);
+  }
+  path.pop();
+}
+
+static void outputJsonString(std::ostream& out, const char* str)
+{
+  out << '"';
+  for (; *str; str++) {
+    if (*str == '"' || *str == '\\') {
+      out << '\\';
+    }
+    out << *str;
+  }
+  out << '"';
+}
+
+/**
+ * Writes a complete ("X") trace event for this node and its children. As the trace only keeps
+ * the accumulated durations, the children are laid out one after the other from the start of
+ * their parent.
+ */
+void TimeTrace::Node::outputChrome(std::ostream& out, int pid, Duration start)
+{
+  using namespace std::chrono;
+  out << "{\"name\":";
+  outputJsonString(out, name);
+  out << ",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << pid
+      << ",\"ts\":" << duration_cast<microseconds>(start).count()
+      << ",\"dur\":" << duration_cast<microseconds>(totalDuration()).count()
+      << ",\"args\":{\"cnt\":" << measurements.cnt() << "}},\n";
+  for (auto& c : children) {
+    c->outputChrome(out, pid, start);
+    start += c->totalDuration();
+  }
+}
+
+/**
+ * Truncates the time trace file at the start of the run. The processes forked later on
+ * only ever append to it.
+ */
+void TimeTrace::initOutputFile()
+{
+  auto fname = env.options->timeTraceFile();
+  if (fname.empty()) {
+    return;
+  }
+  BYPASSING_ALLOCATOR;
+  std::ofstream out(fname.c_str(), std::ios::trunc);
+  if (env.options->timeTraceFormat() == Options::TimeTraceFormat::CHROME) {
+    // the JSON array format of trace events allows to leave the array open, so every process
+    // can append its events without knowing whether it is the last one
+    out << "[\n";
+  }
+  if (out.fail()) {
+    USER_ERROR("Cannot open the time trace file " + fname);
+  }
+}
+
+/**
+ * Appends the trace of this process to the time trace file, if one was requested.
+ */
+void TimeTrace::outputToFile()
+{
+  auto fname = env.options->timeTraceFile();
+  if (!_enabled || fname.empty()) {
+    return;
+  }
+
+  auto now = Clock::now();
+  auto& root = beginOutput(now);
+  vostringstream out;
+  if (env.options->timeTraceFormat() == Options::TimeTraceFormat::CHROME) {
+    auto start = _tmpRoots.size() == 0 ? _epoch : get<1>(_tmpRoots.top());
+    root.outputChrome(out, getpid(), start - _epoch);
+  } else {
+    Stack<const char*> path;
+    root.outputCollapsed(out, path);
+  }
+  endOutput(now);
+
+  // a single write to a file opened for appending does not interleave with the other processes
+  auto content = out.str();
+  int fd = open(fname.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+  if (fd == -1) {
+    USER_ERROR("Cannot open the time trace file " + fname);
+  }
+  auto written = ::write(fd, content.data(), content.size());
+  close(fd);
+  if (written != ssize_t(content.size())) {
+    SYSTEM_FAIL("Writing the time trace file failed.", errno);
   }
 }
 
@@ -44,7 +44,11 @@ namespace Shell {
  * recursive functions.
  * Further it should be noted that the macro introduces some overhead, hence it should also be
  * avoided to be used in parts of the codebase that are called very often and only perform short
- * tasks.
+ * tasks. With --time_trace_sampling the clock is not read on entering and leaving a block, which
+ * removes most of this overhead at the price of only estimating the durations.
+ *
+ * Apart from the pretty printed tree (--time_statistics) the trace can be written to a file
+ * (--time_trace_file) in a format for external profile viewers (--time_trace_format).
  * ```
  */
 #define TIME_TRACE(name)                                                                            \
@@ -125,6 +129,7 @@ private:
       _cnt -= 1;
       _sum -= d;
     }
+    void setSum(Duration d) { _sum = d; }
     Duration sum() const { return _sum; }
     unsigned cnt() const { return _cnt; }
     Duration avg() const { return sum() / cnt(); }
@@ -141,12 +146,17 @@ private:
     const char* name;
     Lib::Stack<unique_ptr<Node>> children;
     Measurements measurements;
-    Node(const char* name) : name(name), children(), measurements() {}
+    /** number of samples taken while this node was the innermost open one */
+    unsigned samples;
+    Node(const char* name) : name(name), children(), measurements(), samples(0) {}
     struct NodeFormatOpts ;
     void printPrettyRec(std::ostream& out, NodeFormatOpts& opts);
     void printPrettySelf(std::ostream& out, NodeFormatOpts& opts);
-    void serialize(std::ostream& out);
     Duration totalDuration() const;
+    Duration selfDuration() const;
+    Duration applySamples(Duration interval);
+    void outputCollapsed(std::ostream& out, Lib::Stack<const char*>& path);
+    void outputChrome(std::ostream& out, int pid, Duration start);
 
     Node flatten();
     struct FlattenState;
@@ -182,14 +192,27 @@ public:
   };
 
   void printPretty(std::ostream& out);
-  void serialize(std::ostream& out);
   void setEnabled(bool);
+  void setSampling(unsigned intervalInMicroseconds);
+  void initOutputFile();
+  void outputToFile();
 private:
+  static void sampleHandler(int);
+  void startSampling();
+  Node& beginOutput(TimePoint now);
+  void endOutput(TimePoint now);
 
   Node _root;
-  Lib::Stack<Node*> _tmpRoots;
+  /** temporary roots together with the time they were set */
+  Lib::Stack<std::tuple<Node*, TimePoint>> _tmpRoots;
   Lib::Stack<std::tuple<Node*, TimePoint>> _stack;
+  /** the innermost open node, read by the sampling signal handler */
+  Node* volatile _current;
+  /** the time the trace was created; inherited by forked children so all processes share it */
+  TimePoint _epoch;
   bool _enabled;
+  /** the sampling interval, zero if every block is timed with the clock */
+  Duration _sampling;
 };
 
 
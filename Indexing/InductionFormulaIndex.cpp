@@ -12,6 +12,9 @@
  * Implements class InductionFormulaIndex.
  */
 
+#include "Lib/Environment.hpp"
+#include "Shell/Statistics.hpp"
+
 #include "InductionFormulaIndex.hpp"
 
 #include "Inferences/Induction.hpp"
@@ -58,7 +61,12 @@ bool InductionFormulaIndex::findOrInsert(const InductionContext& context, Entry*
   auto k = represent(context);
   k.second.first = bound1;
   k.second.second = bound2;
-  return _map.getValuePtr(std::move(k), e);
+  if (_map.getValuePtr(std::move(k), e)) {
+    return true;
+  }
+  // the clausified formulas are reused, only the resolution with the context remains to be done
+  env.statistics->inductionFormulaReuse++;
+  return false;
 }
 
 }
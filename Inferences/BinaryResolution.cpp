@@ -75,16 +75,16 @@ struct BinaryResolution::UnificationsFn
 {
   UnificationsFn(BinaryResolutionIndex* index,bool cU)
   : _index(index),_unificationWithAbstraction(cU) {}
-  VirtualIterator<pair<Literal*, SLQueryResult> > operator()(Literal* lit)
+  auto operator()(Literal* lit)
   {
     if(lit->isEquality()) {
       //Binary resolution is not performed with equality literals
-      return VirtualIterator<pair<Literal*, SLQueryResult> >::getEmpty();
+      return pushPairIntoRightIterator(lit, SLQueryResultIterator::getEmpty());
     }
     if(_unificationWithAbstraction){
-      return pvi( pushPairIntoRightIterator(lit, _index->getUnificationsWithConstraints(lit, true)) );
+      return pushPairIntoRightIterator(lit, _index->getUnificationsWithConstraints(lit, true));
     }
-    return pvi( pushPairIntoRightIterator(lit, _index->getUnifications(lit, true)) );
+    return pushPairIntoRightIterator(lit, _index->getUnifications(lit, true));
   }
 private:
   BinaryResolutionIndex* _index;
@@ -44,6 +44,10 @@ InterpretedEvaluation::InterpretedEvaluation(bool doNormalize, Ordering& orderin
   _simpl(new InterpretedLiteralEvaluator(doNormalize))
 {
   CALL("InterpretedEvaluation::InterpretedEvaluation");
+
+  if (env.options->batchGroundEvaluation()) {
+    _batch = new GroundArithmeticEvaluator();
+  }
 }
 
 InterpretedEvaluation::~InterpretedEvaluation()
@@ -97,11 +101,29 @@ Clause* InterpretedEvaluation::simplify(Clause* cl)
     newLits.ensure(clen);
     unsigned next=0;
     Stack<Literal*> sideConditions;
+
+    if (_batch) {
+      _batched.ensure(clen);
+      _batch->reset();
+      for(unsigned li=0;li<clen; li++) {
+        _batched[li] = _batch->add((*cl)[li]) ? _batch->size() : 0;
+      }
+      _batch->evaluate(_batchResults);
+      env.statistics->batchEvaluatedLiterals += _batch->size();
+    }
+
     for(unsigned li=0;li<clen; li++) {
       Literal* lit=(*cl)[li];
       Literal* res;
       bool constant, constTrue;
-      bool litMod=simplifyLiteral(lit, constant, res, constTrue,sideConditions);
+      bool litMod;
+      if (_batch && _batched[li]) {
+        litMod = true;
+        constant = true;
+        constTrue = _batchResults[_batched[li]-1];
+      } else {
+        litMod=simplifyLiteral(lit, constant, res, constTrue,sideConditions);
+      }
       if(!litMod) {
         newLits[next++]=lit;
         continue;
@@ -18,8 +18,11 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DArray.hpp"
 #include "Lib/DHMap.hpp"
+#include "Lib/ScopedPtr.hpp"
 
+#include "Kernel/GroundArithmeticEvaluator.hpp"
 #include "Kernel/InterpretedLiteralEvaluator.hpp"
 #include "Kernel/Theory.hpp"
 
@@ -42,6 +45,11 @@ private:
   bool simplifyLiteral(Literal* lit, bool& constant, Literal*& res, bool& constantTrue,Stack<Literal*>& sideConditions);
 
   InterpretedLiteralEvaluator* _simpl;
+  /** evaluates the ground arithmetic comparisons of a clause at once, if --batch_ground_evaluation is on */
+  ScopedPtr<GroundArithmeticEvaluator> _batch;
+  Stack<bool> _batchResults;
+  /** literal li of the clause was evaluated in the batch if _batched[li], its value is _batchResults[_batched[li]-1] */
+  DArray<unsigned> _batched;
 };
 
 };
@@ -15,6 +15,7 @@
 #include "Lib/VirtualIterator.hpp"
 #include "Kernel/SortHelper.hpp"
 #include "Kernel/BottomUpEvaluation/PolyNf.hpp"
+#include "Kernel/PolynomialNormalizer.hpp"
 
 #define DEBUG(...) //DBG(__VA_ARGS__)
 using namespace Lib;
@@ -238,7 +239,7 @@ Option<PolyNf> PolynomialEvaluation::evaluate(PolyNf normalized) const
       );
     }
   };
-  static Memo::Hashed<PolyNf, PolyNf, StlHash> memo;
+  static auto memo = arithmeticMemo<PolyNf, PolyNf>();
   auto out = evaluateBottomUp(normalized, Eval{ *this }, memo);
   if (out == normalized) {
     return Option<PolyNf>();
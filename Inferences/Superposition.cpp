@@ -84,18 +84,19 @@ struct Superposition::RewritableResultsFn
 {
   RewritableResultsFn(SuperpositionSubtermIndex* index,bool wc,bool ea) : _index(index),
                      _withC(wc), _extByAbs(ea) {}
-  VirtualIterator<pair<pair<Literal*, TermList>, TermQueryResult> > operator()(pair<Literal*, TermList> arg)
+  auto operator()(pair<Literal*, TermList> arg)
   {
     CALL("Superposition::RewritableResultsFn()");
+    // the index results are virtual already, so there is no need to wrap them once more
     if(_withC){
-      return pvi( pushPairIntoRightIterator(arg, _index->getUnificationsWithConstraints(arg.second, true)) );
+      return pushPairIntoRightIterator(arg, _index->getUnificationsWithConstraints(arg.second, true));
     }
     else if(_extByAbs){
       TermList sort = SortHelper::getTermSort(arg.second, arg.first);
-      return pvi( pushPairIntoRightIterator(arg, _index->getUnificationsUsingSorts(arg.second, sort, true)) );
+      return pushPairIntoRightIterator(arg, _index->getUnificationsUsingSorts(arg.second, sort, true));
     }
     else{
-      return pvi( pushPairIntoRightIterator(arg, _index->getUnifications(arg.second, true)) );
+      return pushPairIntoRightIterator(arg, _index->getUnifications(arg.second, true));
     }
   }
 private:
@@ -108,12 +109,12 @@ struct Superposition::RewriteableSubtermsFn
 {
   RewriteableSubtermsFn(Ordering& ord) : _ord(ord) {}
 
-  VirtualIterator<pair<Literal*, TermList> > operator()(Literal* lit)
+  auto operator()(Literal* lit)
   {
     CALL("Superposition::RewriteableSubtermsFn()");
     TermIterator it = env.options->combinatorySup() ? EqHelper::getFoSubtermIterator(lit, _ord) :
                                                       EqHelper::getSubtermIterator(lit, _ord);
-    return pvi( pushPairIntoRightIterator(lit, it) );
+    return pushPairIntoRightIterator(lit, it);
   }
 
 private:
@@ -124,18 +125,18 @@ struct Superposition::ApplicableRewritesFn
 {
   ApplicableRewritesFn(SuperpositionLHSIndex* index, bool wc, bool ea) : _index(index), 
                       _withC(wc), _extByAbs(ea) {}
-  VirtualIterator<pair<pair<Literal*, TermList>, TermQueryResult> > operator()(pair<Literal*, TermList> arg)
+  auto operator()(pair<Literal*, TermList> arg)
   {
     CALL("Superposition::ApplicableRewritesFn()");
     if(_withC){
-      return pvi( pushPairIntoRightIterator(arg, _index->getUnificationsWithConstraints(arg.second, true)) );
+      return pushPairIntoRightIterator(arg, _index->getUnificationsWithConstraints(arg.second, true));
     }  
     else if(_extByAbs){
       TermList sort = SortHelper::getTermSort(arg.second, arg.first);
-      return pvi( pushPairIntoRightIterator(arg, _index->getUnificationsUsingSorts(arg.second, sort, true)) );
+      return pushPairIntoRightIterator(arg, _index->getUnificationsUsingSorts(arg.second, sort, true));
     }
     else{
-      return pvi( pushPairIntoRightIterator(arg, _index->getUnifications(arg.second, true)) );
+      return pushPairIntoRightIterator(arg, _index->getUnifications(arg.second, true));
     }
   }
 private:
@@ -396,11 +396,22 @@ void IGAlgorithm::finishGeneratingClause(Clause* orig, ResultSubstitution& subst
 {
   CALL("IGAlgorithm::finishGeneratingClause");
 
+  env.statistics->instGenGeneratedClauses++;
+
+  // Instances that are variants of clauses we already have would be
+  // rejected by addClause() anyway, so we save building and simplifying them
+  {
+    TIME_TRACE("inst gen variant detection");
+    if (_variantIdx->retrieveVariants(genLits.begin(), genLits.size()).hasNext()) {
+      env.statistics->instGenRedundantClauses++;
+      return;
+    }
+  }
+
   Clause* res = Clause::fromStack(genLits, GeneratingInference1(InferenceRule::INSTANCE_GENERATION, orig));
   // make age also depend on the age of otherCl
   res->setAge(max(orig->age(), otherCl->age())+1);
 
-  env.statistics->instGenGeneratedClauses++;
   bool added = addClause(res);
   (void)added;
 
@@ -766,6 +777,11 @@ void IGAlgorithm::restartWithCurrentClauses()
 {
   CALL("IGAlgorithm::restartWithCurrentClauses");
 
+  if(_opt.instGenIncrementalRestart()) {
+    restartIncrementally();
+    return;
+  }
+
   static RCClauseStack allClauses;
   allClauses.reset();
 
@@ -788,6 +804,31 @@ void IGAlgorithm::restartWithCurrentClauses()
   }
 }
 
+/**
+ * Restart with the current clauses, keeping everything that does not depend
+ * on the selection.
+ *
+ * All the active and passive clauses are already grounded in the SAT solver
+ * and stored in the variant index, so instead of passing them through
+ * addClause() again, we only forget the selected literals and put
+ * the active clauses back to passive.
+ */
+void IGAlgorithm::restartIncrementally()
+{
+  CALL("IGAlgorithm::restartIncrementally");
+
+  _deactivated.reset();
+  _deactivatedSet.reset();
+
+  delete _selected;
+  _selected = new LiteralSubstitutionTree();
+
+  while(_active.isNonEmpty()) {
+    //the reference held by active is passed on to passive
+    _passive.add(_active.popWithoutDec());
+  }
+}
+
 void IGAlgorithm::restartFromBeginning()
 {
   CALL("IGAlgorithm::restartFromBeginning");
@@ -84,6 +84,7 @@ private:
   bool addClause(Clause* cl);
 
   void restartWithCurrentClauses();
+  void restartIncrementally();
   void restartFromBeginning();
 
 
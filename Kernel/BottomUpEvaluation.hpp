@@ -66,6 +66,80 @@ namespace Memo {
     }
   };
 
+  /** 
+   * A memoization realized as a hashmap that keeps at most @b limit entries (unbounded if the limit is 0),
+   * for memos that live as long as the whole proof search.
+   *
+   * Eviction is CLOCK (second chance) done in batches: a hit marks the entry as referenced, and when the 
+   * map is full one sweep keeps the referenced entries, unmarked, and drops the others. At most half of 
+   * the limit survives a sweep, so sweeping costs amortised constant time per insertion.
+   *
+   * Hits, misses and evicted entries are added to the counters given on construction.
+   */
+  template<class Arg, class Result, class Hash = DefaultHash>
+  class Bounded 
+  {
+    struct Entry 
+    {
+      Result result;
+      bool referenced;
+    };
+    Map<Arg, Entry, Hash> _memo;
+    unsigned _limit;
+    unsigned long& _hits;
+    unsigned long& _misses;
+    unsigned long& _evictions;
+
+    void evict()
+    {
+      CALL("Memo::Bounded::evict")
+      Map<Arg, Entry, Hash> kept;
+      int keep = _limit / 2;
+      auto it = _memo.iter();
+      while (it.hasNext()) {
+        auto& e = it.next();
+        if (e.value().referenced && kept.size() < keep) {
+          kept.insert(std::move(e).key(), Entry { std::move(e).value().result, false });
+        }
+      }
+      _evictions += _memo.size() - kept.size();
+      _memo = std::move(kept);
+    }
+
+  public:
+    Bounded(unsigned limit, unsigned long& hits, unsigned long& misses, unsigned long& evictions) 
+      : _memo(decltype(_memo)()), _limit(limit), _hits(hits), _misses(misses), _evictions(evictions) {}
+
+    template<class Init> Result getOrInit(Arg const& orig, Init init) 
+    { 
+      auto cached = _memo.getPtr(orig);
+      if (cached) {
+        _hits++;
+        cached->referenced = true;
+        return cached->result;
+      }
+      _misses++;
+      if (_limit && unsigned(_memo.size()) >= _limit) {
+        evict();
+      }
+      Result out = init();
+      _memo.insert(Arg(orig), Entry { out, false });
+      return out;
+    }
+
+    Option<Result> get(const Arg& orig) 
+    { 
+      auto cached = _memo.getPtr(orig);
+      if (cached) {
+        _hits++;
+        cached->referenced = true;
+        return Option<Result>(cached->result);
+      } else {
+        return Option<Result>();
+      }
+    }
+  };
+
 } // namespace Memo
 
 /** 
@@ -548,7 +548,7 @@ unsigned Clause::getNumeralWeight() const {
       IntegerConstantType intVal;
 
       if (theory->tryInterpretConstant(t, intVal)) {
-        int w = BitUtils::log2(Int::safeAbs(intVal.toInner())) - 1;
+        int w = intVal.log2Abs() - 1;
         if (w > 0) {
           res += w;
         }
@@ -567,8 +567,8 @@ unsigned Clause::getNumeralWeight() const {
       if (!haveRat) {
         continue;
       }
-      int wN = BitUtils::log2(Int::safeAbs(ratVal.numerator().toInner())) - 1;
-      int wD = BitUtils::log2(Int::safeAbs(ratVal.denominator().toInner())) - 1;
+      int wN = ratVal.numerator().log2Abs() - 1;
+      int wD = ratVal.denominator().log2Abs() - 1;
       int v = wN + wD;
       if (v > 0) {
         res += v;
@@ -281,31 +281,38 @@ TermIterator EqHelper::getLHSIterator(Literal* lit, const Ordering& ord)
 {
   CALL("EqHelper::getLHSIterator");
 
+  return pvi( getStaticLHSIterator(lit, ord) );
+}
+
+/**
+ * Same as getLHSIterator, but without allocating the iterator.
+ */
+EqHelper::EqualitySidesIterator EqHelper::getStaticLHSIterator(Literal* lit, const Ordering& ord)
+{
+  CALL("EqHelper::getStaticLHSIterator");
+
   if (lit->isEquality()) {
     if (lit->isNegative()) {
-      return TermIterator::getEmpty();
+      return EqualitySidesIterator();
     }
     TermList t0=*lit->nthArgument(0);
     TermList t1=*lit->nthArgument(1);
     switch(ord.getEqualityArgumentOrder(lit))
     {
     case Ordering::INCOMPARABLE:
-      return pvi( getConcatenatedIterator(getSingletonIterator(t0),
-	      getSingletonIterator(t1)) );
+      return EqualitySidesIterator{t0, t1};
     case Ordering::GREATER:
     case Ordering::GREATER_EQ:
-      return pvi( getSingletonIterator(t0) );
+      return EqualitySidesIterator{t0};
     case Ordering::LESS:
     case Ordering::LESS_EQ:
-      return pvi( getSingletonIterator(t1) );
+      return EqualitySidesIterator{t1};
     //there should be no equality literals of equal terms
     case Ordering::EQUAL:
       ASSERTION_VIOLATION;
     }
-    return TermIterator::getEmpty();
-  } else {
-    return TermIterator::getEmpty();
   }
+  return EqualitySidesIterator();
 }
 
 /**
@@ -327,12 +334,28 @@ TermIterator EqHelper::getSuperpositionLHSIterator(Literal* lit, const Ordering&
 {
   CALL("EqHelper::getSuperpositionLHSIterator");
 
+  return pvi( getStaticSuperpositionLHSIterator(lit, ord, opt) );
+}
+
+/**
+ * Same as getSuperpositionLHSIterator, but without allocating the iterator.
+ */
+EqHelper::EqualitySidesIterator EqHelper::getStaticSuperpositionLHSIterator(Literal* lit, const Ordering& ord, const Options& opt)
+{
+  CALL("EqHelper::getStaticSuperpositionLHSIterator");
+
+  auto lhss = getStaticLHSIterator(lit, ord);
   if (opt.superpositionFromVariables()) {
-    return getLHSIterator(lit, ord);
+    return lhss;
   }
-  else {
-    return pvi( getFilteredIterator(getLHSIterator(lit, ord), IsNonVariable()) );
+  EqualitySidesIterator res;
+  while (lhss.hasNext()) {
+    TermList lhs = lhss.next();
+    if (IsNonVariable()(lhs)) {
+      res.push(lhs);
+    }
   }
+  return res;
 }
 
 
@@ -448,9 +471,18 @@ TermIterator EqHelper::getEqualityArgumentIterator(Literal* lit)
   CALL("EqHelper::getEqualityArgumentIterator");
   ASS(lit->isEquality());
 
-  return pvi( getConcatenatedIterator(
-	  getSingletonIterator(*lit->nthArgument(0)),
-	  getSingletonIterator(*lit->nthArgument(1))) );
+  return pvi( getStaticEqualityArgumentIterator(lit) );
+}
+
+/**
+ * Same as getEqualityArgumentIterator, but without allocating the iterator.
+ */
+EqHelper::EqualitySidesIterator EqHelper::getStaticEqualityArgumentIterator(Literal* lit)
+{
+  CALL("EqHelper::getStaticEqualityArgumentIterator");
+  ASS(lit->isEquality());
+
+  return EqualitySidesIterator{*lit->nthArgument(0), *lit->nthArgument(1)};
 }
 
 
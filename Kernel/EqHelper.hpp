@@ -46,6 +46,12 @@ public:
   static TermIterator getDemodulationLHSIterator(Literal* lit, bool forward, const Ordering& ord, const Options& opt);
   static TermIterator getEqualityArgumentIterator(Literal* lit);
 
+  /** At most the two sides of an equality. Unlike TermIterator it does not allocate. */
+  typedef InlineArrayIterator<TermList, 2> EqualitySidesIterator;
+  static EqualitySidesIterator getStaticLHSIterator(Literal* lit, const Ordering& ord);
+  static EqualitySidesIterator getStaticSuperpositionLHSIterator(Literal* lit, const Ordering& ord, const Options& opt);
+  static EqualitySidesIterator getStaticEqualityArgumentIterator(Literal* lit);
+
   //WARNING, this function cannot be used when @param t is a sort.
   static Term* replace(Term* t, TermList what, TermList by);
   static Literal* replace(Literal* lit, TermList what, TermList by);
@@ -54,9 +60,9 @@ public:
   {
     LHSIteratorFn(const Ordering& ord) : _ord(ord) {}
 
-    VirtualIterator<pair<Literal*, TermList> > operator()(Literal* lit)
+    auto operator()(Literal* lit)
     {
-      return pvi( pushPairIntoRightIterator(lit, getLHSIterator(lit, _ord)) );
+      return pushPairIntoRightIterator(lit, getStaticLHSIterator(lit, _ord));
     }
   private:
     const Ordering& _ord;
@@ -66,9 +72,9 @@ public:
   {
     SuperpositionLHSIteratorFn(const Ordering& ord, const Options& opt) : _ord(ord), _opt(opt) {}
 
-    VirtualIterator<pair<Literal*, TermList> > operator()(Literal* lit)
+    auto operator()(Literal* lit)
     {
-      return pvi( pushPairIntoRightIterator(lit, getSuperpositionLHSIterator(lit, _ord, _opt)) );
+      return pushPairIntoRightIterator(lit, getStaticSuperpositionLHSIterator(lit, _ord, _opt));
     }
   private:
     const Ordering& _ord;
@@ -90,9 +96,9 @@ public:
 
   struct EqualityArgumentIteratorFn
   {
-    VirtualIterator<pair<Literal*, TermList> > operator()(Literal* lit)
+    auto operator()(Literal* lit)
     {
-      return pvi( pushPairIntoRightIterator(lit, getEqualityArgumentIterator(lit)) );
+      return pushPairIntoRightIterator(lit, getStaticEqualityArgumentIterator(lit));
     }
   };
 
@@ -0,0 +1,258 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file GroundArithmeticEvaluator.cpp
+ * Implements class GroundArithmeticEvaluator.
+ */
+
+#include "Debug/Tracer.hpp"
+
+#include "NumTraits.hpp"
+#include "SortHelper.hpp"
+#include "Term.hpp"
+
+#include "GroundArithmeticEvaluator.hpp"
+
+namespace Kernel
+{
+
+using namespace Lib;
+
+void GroundArithmeticEvaluator::reset()
+{
+  _code.reset();
+  _intConstants.reset();
+  _ratConstants.reset();
+  _literals = 0;
+}
+
+bool GroundArithmeticEvaluator::add(Literal* lit)
+{
+  CALL("GroundArithmeticEvaluator::add");
+
+  if (!lit->ground()) {
+    return false;
+  }
+
+  bool integer;
+  Op comparison;
+  // compare the arguments in the reverse order (a > b is b < a)
+  bool swap = false;
+  if (lit->isEquality()) {
+    TermList sort = SortHelper::getEqualityArgumentSort(lit);
+    if (sort == IntTraits::sort()) {
+      integer = true;
+    } else if (sort == RatTraits::sort() || sort == RealTraits::sort()) {
+      integer = false;
+    } else {
+      return false;
+    }
+    comparison = integer ? INT_EQ : RAT_EQ;
+  } else {
+    if (!theory->isInterpretedPredicate(lit->functor())) {
+      return false;
+    }
+    switch (theory->interpretPredicate(lit)) {
+      case Theory::INT_LESS:           integer = true;  comparison = INT_LESS; break;
+      case Theory::INT_LESS_EQUAL:     integer = true;  comparison = INT_LEQ;  break;
+      case Theory::INT_GREATER:        integer = true;  comparison = INT_LESS; swap = true; break;
+      case Theory::INT_GREATER_EQUAL:  integer = true;  comparison = INT_LEQ;  swap = true; break;
+      case Theory::RAT_LESS:
+      case Theory::REAL_LESS:          integer = false; comparison = RAT_LESS; break;
+      case Theory::RAT_LESS_EQUAL:
+      case Theory::REAL_LESS_EQUAL:    integer = false; comparison = RAT_LEQ;  break;
+      case Theory::RAT_GREATER:
+      case Theory::REAL_GREATER:       integer = false; comparison = RAT_LESS; swap = true; break;
+      case Theory::RAT_GREATER_EQUAL:
+      case Theory::REAL_GREATER_EQUAL: integer = false; comparison = RAT_LEQ;  swap = true; break;
+      default:
+        return false;
+    }
+  }
+
+  size_t codeLen = _code.size();
+  size_t intLen = _intConstants.size();
+  size_t ratLen = _ratConstants.size();
+  TermList lhs = *lit->nthArgument(swap ? 1 : 0);
+  TermList rhs = *lit->nthArgument(swap ? 0 : 1);
+  if (!compile(lhs, integer) || !compile(rhs, integer)) {
+    _code.truncate(codeLen);
+    _intConstants.truncate(intLen);
+    _ratConstants.truncate(ratLen);
+    return false;
+  }
+  emit(comparison);
+  if (lit->isNegative()) {
+    emit(NOT);
+  }
+  _literals++;
+  return true;
+}
+
+/**
+ * Append the code computing the value of @b t, which is of the integer sort if @b integer
+ * and of the rational or real sort otherwise.
+ */
+bool GroundArithmeticEvaluator::compile(TermList t, bool integer)
+{
+  CALL("GroundArithmeticEvaluator::compile");
+
+  if (!t.isTerm()) {
+    return false;
+  }
+  Term* trm = t.term();
+  if (integer) {
+    IntegerConstantType num;
+    if (theory->tryInterpretConstant(trm, num)) {
+      emit(PUSH_INT, _intConstants.size());
+      _intConstants.push(num);
+      return true;
+    }
+  } else {
+    RationalConstantType rat;
+    RealConstantType real;
+    if (theory->tryInterpretConstant(trm, rat)) {
+      emit(PUSH_RAT, _ratConstants.size());
+      _ratConstants.push(rat);
+      return true;
+    }
+    if (theory->tryInterpretConstant(trm, real)) {
+      emit(PUSH_RAT, _ratConstants.size());
+      _ratConstants.push(real);
+      return true;
+    }
+  }
+  if (!theory->isInterpretedFunction(trm)) {
+    return false;
+  }
+
+  Op op;
+  bool intOp;
+  switch (theory->interpretFunction(trm)) {
+    case Theory::INT_UNARY_MINUS:  op = INT_NEG; intOp = true;  break;
+    case Theory::INT_PLUS:         op = INT_ADD; intOp = true;  break;
+    case Theory::INT_MINUS:        op = INT_SUB; intOp = true;  break;
+    case Theory::INT_MULTIPLY:     op = INT_MUL; intOp = true;  break;
+    case Theory::RAT_UNARY_MINUS:
+    case Theory::REAL_UNARY_MINUS: op = RAT_NEG; intOp = false; break;
+    case Theory::RAT_PLUS:
+    case Theory::REAL_PLUS:        op = RAT_ADD; intOp = false; break;
+    case Theory::RAT_MINUS:
+    case Theory::REAL_MINUS:       op = RAT_SUB; intOp = false; break;
+    case Theory::RAT_MULTIPLY:
+    case Theory::REAL_MULTIPLY:    op = RAT_MUL; intOp = false; break;
+    default:
+      return false;
+  }
+  if (intOp != integer) {
+    return false;
+  }
+  for (unsigned i = 0; i < trm->numTermArguments(); i++) {
+    if (!compile(trm->termArg(i), integer)) {
+      return false;
+    }
+  }
+  emit(op);
+  return true;
+}
+
+void GroundArithmeticEvaluator::evaluate(Stack<bool>& results)
+{
+  CALL("GroundArithmeticEvaluator::evaluate");
+
+  results.reset();
+  _ints.reset();
+  _rats.reset();
+
+  for (const Instruction& ins : _code) {
+    switch (ins.op) {
+      case PUSH_INT:
+        _ints.push(_intConstants[ins.constant]);
+        break;
+      case INT_NEG:
+        _ints.top() = -_ints.top();
+        break;
+      case INT_ADD: {
+        IntegerConstantType r = _ints.pop();
+        _ints.top() = _ints.top() + r;
+        break;
+      }
+      case INT_SUB: {
+        IntegerConstantType r = _ints.pop();
+        _ints.top() = _ints.top() - r;
+        break;
+      }
+      case INT_MUL: {
+        IntegerConstantType r = _ints.pop();
+        _ints.top() = _ints.top() * r;
+        break;
+      }
+      case INT_EQ: {
+        IntegerConstantType r = _ints.pop();
+        results.push(_ints.pop() == r);
+        break;
+      }
+      case INT_LESS: {
+        IntegerConstantType r = _ints.pop();
+        results.push(_ints.pop() < r);
+        break;
+      }
+      case INT_LEQ: {
+        IntegerConstantType r = _ints.pop();
+        results.push(_ints.pop() <= r);
+        break;
+      }
+      case PUSH_RAT:
+        _rats.push(_ratConstants[ins.constant]);
+        break;
+      case RAT_NEG:
+        _rats.top() = -_rats.top();
+        break;
+      case RAT_ADD: {
+        RationalConstantType r = _rats.pop();
+        _rats.top() = _rats.top() + r;
+        break;
+      }
+      case RAT_SUB: {
+        RationalConstantType r = _rats.pop();
+        _rats.top() = _rats.top() - r;
+        break;
+      }
+      case RAT_MUL: {
+        RationalConstantType r = _rats.pop();
+        _rats.top() = _rats.top() * r;
+        break;
+      }
+      case RAT_EQ: {
+        RationalConstantType r = _rats.pop();
+        results.push(_rats.pop() == r);
+        break;
+      }
+      case RAT_LESS: {
+        RationalConstantType r = _rats.pop();
+        results.push(_rats.pop() < r);
+        break;
+      }
+      case RAT_LEQ: {
+        RationalConstantType r = _rats.pop();
+        results.push(_rats.pop() <= r);
+        break;
+      }
+      case NOT:
+        results.top() = !results.top();
+        break;
+    }
+  }
+  ASS(_ints.isEmpty())
+  ASS(_rats.isEmpty())
+  ASS_EQ(results.size(), _literals)
+}
+
+}
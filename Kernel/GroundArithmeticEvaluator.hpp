@@ -0,0 +1,83 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file GroundArithmeticEvaluator.hpp
+ * Defines class GroundArithmeticEvaluator.
+ */
+
+#ifndef __GroundArithmeticEvaluator__
+#define __GroundArithmeticEvaluator__
+
+#include "Forwards.hpp"
+
+#include "Lib/Stack.hpp"
+
+#include "Theory.hpp"
+
+namespace Kernel {
+
+/**
+ * Evaluates a batch of ground arithmetic comparisons (=, <, <=, >, >= of terms built from
+ * numerals, unary minus, +, - and *) in one pass.
+ *
+ * Every literal added is compiled into a postfix program over a flat array of instructions,
+ * the programs of the batch are concatenated and a single loop evaluates all of them on value
+ * stacks. Unlike InterpretedLiteralEvaluator, no shared terms are created for the intermediate
+ * results.
+ */
+class GroundArithmeticEvaluator
+{
+public:
+  CLASS_NAME(GroundArithmeticEvaluator);
+  USE_ALLOCATOR(GroundArithmeticEvaluator);
+
+  GroundArithmeticEvaluator() : _literals(0) {}
+
+  /** Remove all literals from the batch */
+  void reset();
+  /**
+   * Add @b lit to the batch. Return false, leaving the batch unchanged, if @b lit is not 
+   * a ground arithmetic comparison this class can evaluate.
+   */
+  bool add(Literal* lit);
+  /** Evaluate the literals of the batch, @b results gets their truth values in the order they were added */
+  void evaluate(Stack<bool>& results);
+  /** Number of literals in the batch */
+  unsigned size() const { return _literals; }
+
+private:
+  enum Op : unsigned char {
+    PUSH_INT, INT_NEG, INT_ADD, INT_SUB, INT_MUL, INT_EQ, INT_LESS, INT_LEQ,
+    PUSH_RAT, RAT_NEG, RAT_ADD, RAT_SUB, RAT_MUL, RAT_EQ, RAT_LESS, RAT_LEQ,
+    NOT
+  };
+  struct Instruction
+  {
+    Op op;
+    /** index of the constant for PUSH_INT and PUSH_RAT */
+    unsigned constant;
+  };
+
+  bool compile(TermList t, bool integer);
+  void emit(Op op, unsigned constant = 0)
+  { _code.push(Instruction{ op, constant }); }
+
+  Stack<Instruction> _code;
+  Stack<IntegerConstantType> _intConstants;
+  Stack<RationalConstantType> _ratConstants;
+  /** evaluation stacks, kept between batches to reuse their memory */
+  Stack<IntegerConstantType> _ints;
+  Stack<RationalConstantType> _rats;
+  unsigned _literals;
+};
+
+}
+
+#endif // __GroundArithmeticEvaluator__
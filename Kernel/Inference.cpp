@@ -113,6 +113,21 @@ void Inference::destroy()
   }
 }
 
+void Inference::detachPremises(bool fromInput, bool fromGoal)
+{
+  CALL("Inference::detachPremises");
+
+  if (_kind == Kind::INFERENCE_FROM_SAT_REFUTATION) {
+    return;
+  }
+  _detachedFromInput = fromInput;
+  _detachedFromGoal = fromGoal;
+  destroy();
+  _kind = Kind::INFERENCE_012;
+  _ptr1 = nullptr;
+  _ptr2 = nullptr;
+}
+
 Inference::Inference(const FromSatRefutation& fsr) {
   CALL("Inference::Inference(FromSatRefutation)");
 
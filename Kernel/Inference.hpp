@@ -727,6 +727,8 @@ private:
     _inputType = inputType;
     _rule = r;
     _included = false;
+    _detachedFromInput = false;
+    _detachedFromGoal = false;
     _inductionDepth = 0;
     _XXNarrows = 0;
     _reductions = 0;
@@ -806,6 +808,18 @@ public:
    */
   void destroy();
 
+  /**
+   * Drop the links to the premises, decreasing their reference counters.
+   * The rule and all the other information is kept, and so is whether the
+   * dropped derivation contains an input unit (@b fromInput) and a goal
+   * unit (@b fromGoal), see Unit::derivedFromInput and Unit::derivedFromGoalCheck.
+   *
+   * Only meant to be used once the derivation is recorded elsewhere
+   * (see InferenceTrace). Inferences from SAT refutations are left intact,
+   * since they still need their premises for minimisation.
+   */
+  void detachPremises(bool fromInput, bool fromGoal);
+
   /**
    * Since we treat Inferences as PODs, this is intentionally left empty.
    *
@@ -947,6 +961,11 @@ public:
   bool isProxyAxiomsDescendant() const { return _proxyAxiomsDescendant; }
   void setProxyAxiomsDescendant(bool val) { _proxyAxiomsDescendant=val; }
 
+  /** true if the derivation dropped by detachPremises contains an input unit */
+  bool detachedFromInput() const { return _detachedFromInput; }
+  /** true if the derivation dropped by detachPremises contains a goal unit */
+  bool detachedFromGoal() const { return _detachedFromGoal; }
+
   bool isHolAxiomsDescendant() const { return _holAxiomsDescendant; }
   void setHolAxiomsDescendant(bool val) { _holAxiomsDescendant=val; }  
 
@@ -995,6 +1014,9 @@ private:
   unsigned _proxyAxiomsDescendant : 1;
   /** clause is descended only from proxy or combinator axioms */
   unsigned _holAxiomsDescendant : 1;
+  /** see detachPremises */
+  unsigned _detachedFromInput : 1;
+  unsigned _detachedFromGoal : 1;
   /** Induction depth **/
   unsigned _inductionDepth : 5;
 
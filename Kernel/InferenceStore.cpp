@@ -43,6 +43,7 @@
 #include "SortHelper.hpp"
 
 #include "InferenceStore.hpp"
+#include "InferenceTrace.hpp"
 
 //TODO: when we delete clause, we should also delete all its records from the inference store
 
@@ -119,7 +120,7 @@ void InferenceStore::recordIntroducedSplitName(Unit* u, vstring name)
  * This will first check if the unit was generated by a special inference that was
  * recorded in the InferenceStore and if not, use the inference stored in the unit itself
  */
-UnitIterator InferenceStore::getParents(Unit* us, InferenceRule& rule)
+UnitIterator InferenceStore::getParents(Unit* us, InferenceRule& rule, bool minimize)
 {
   CALL("InferenceStore::getParents/2");
   ASS_NEQ(us,0);
@@ -131,7 +132,9 @@ UnitIterator InferenceStore::getParents(Unit* us, InferenceRule& rule)
   // opportunity to shrink the premise list
   // (currently applies if this was a SAT-based inference
   // and the solver didn't provide a proper proof nor a core)
-  inf.minimizePremises();
+  if (minimize) {
+    inf.minimizePremises();
+  }
 
   Inference::Iterator iit = inf.iterator();
   while(inf.hasNext(iit)) {
@@ -261,6 +264,68 @@ struct UnitNumberComparator
   }
 };
 
+/**
+ * Count the proof step derived by @b rule in the statistics of the proof
+ */
+void InferenceStore::countInProof(InferenceRule rule)
+{
+  CALL("InferenceStore::countInProof");
+
+  // TODO: This does not reflect the way we count applications in Induction
+  // since there an entire induction formula resolved is 1 application, here
+  // each resolution step counts as one, counting potentially much more
+  // switch (rule) {
+  //   case InferenceRule::GEN_INDUCTION_HYPERRESOLUTION:
+  //     env.statistics->generalizedInductionApplicationInProof++;
+  //   case InferenceRule::INDUCTION_HYPERRESOLUTION:
+  //     env.statistics->inductionApplicationInProof++;
+  //     break;
+  //   default:
+  //     ;
+  // }
+  switch (rule) {
+    case InferenceRule::STRUCT_INDUCTION_AXIOM:
+      env.statistics->structInductionInProof++;
+      break;
+    case InferenceRule::INT_INF_UP_INDUCTION_AXIOM:
+    case InferenceRule::INT_INF_DOWN_INDUCTION_AXIOM:
+      env.statistics->intInfInductionInProof++;
+      break;
+    case InferenceRule::INT_FIN_UP_INDUCTION_AXIOM:
+    case InferenceRule::INT_FIN_DOWN_INDUCTION_AXIOM:
+      env.statistics->intFinInductionInProof++;
+      break;
+    case InferenceRule::INT_DB_UP_INDUCTION_AXIOM:
+    case InferenceRule::INT_DB_DOWN_INDUCTION_AXIOM:
+      env.statistics->intDBInductionInProof++;
+      break;
+    default:
+      ;
+  }
+  switch (rule) {
+    case InferenceRule::INT_INF_UP_INDUCTION_AXIOM:
+      env.statistics->intInfUpInductionInProof++;
+      break;
+    case InferenceRule::INT_INF_DOWN_INDUCTION_AXIOM:
+      env.statistics->intInfDownInductionInProof++;
+      break;
+    case InferenceRule::INT_FIN_UP_INDUCTION_AXIOM:
+      env.statistics->intFinUpInductionInProof++;
+      break;
+    case InferenceRule::INT_FIN_DOWN_INDUCTION_AXIOM:
+      env.statistics->intFinDownInductionInProof++;
+      break;
+    case InferenceRule::INT_DB_UP_INDUCTION_AXIOM:
+      env.statistics->intDBUpInductionInProof++;
+      break;
+    case InferenceRule::INT_DB_DOWN_INDUCTION_AXIOM:
+      env.statistics->intDBDownInductionInProof++;
+      break;
+    default:
+      ;
+  }
+}
+
 struct InferenceStore::ProofPrinter
 {
   CLASS_NAME(InferenceStore::ProofPrinter);
@@ -273,6 +338,7 @@ struct InferenceStore::ProofPrinter
 
     outputAxiomNames=env.options->outputAxiomNames();
     delayPrinting=true;
+    minimize=true;
   }
 
   void scheduleForPrinting(Unit* us)
@@ -285,17 +351,38 @@ struct InferenceStore::ProofPrinter
 
   virtual ~ProofPrinter() {}
 
-  virtual void print()
+  void print()
   {
     CALL("InferenceStore::ProofPrinter::print");
 
+    printPrologue();
     while(outKernel.isNonEmpty()) {
       Unit* cs=outKernel.pop();
       handleStep(cs);
     }
     if(delayPrinting) printDelayed();
+    printEpilogue();
   }
 
+  /**
+   * Print the step of @b cs on its own, with its premises as they are,
+   * for the proof to be put together later (see InferenceTrace)
+   */
+  void printSingleStep(Unit* cs)
+  {
+    CALL("InferenceStore::ProofPrinter::printSingleStep");
+
+    minimize=false;
+    if (!hideProofStep(cs->inference().rule())) {
+      printStep(cs);
+    }
+  }
+
+  /** what is printed before the steps of the proof */
+  virtual void printPrologue() {}
+  /** what is printed after the steps of the proof */
+  virtual void printEpilogue() {}
+
 protected:
 
   virtual bool hideProofStep(InferenceRule rule)
@@ -316,62 +403,11 @@ protected:
     CALL("InferenceStore::ProofPrinter::printStep");
 
     InferenceRule rule;
-    UnitIterator parents=_is->getParents(cs, rule);
-
-    cs->inference().updateStatistics(); // in particular, update inductionDepth (which could have decreased, since we might have fewer parents after miniminization)
-
-    // TODO: This does not reflect the way we count applications in Induction
-    // since there an entire induction formula resolved is 1 application, here
-    // each resolution step counts as one, counting potentially much more
-    // switch (rule) {
-    //   case InferenceRule::GEN_INDUCTION_HYPERRESOLUTION:
-    //     env.statistics->generalizedInductionApplicationInProof++;
-    //   case InferenceRule::INDUCTION_HYPERRESOLUTION:
-    //     env.statistics->inductionApplicationInProof++;
-    //     break;
-    //   default:
-    //     ;
-    // }
-    switch (rule) {
-      case InferenceRule::STRUCT_INDUCTION_AXIOM:
-        env.statistics->structInductionInProof++;
-        break;
-      case InferenceRule::INT_INF_UP_INDUCTION_AXIOM:
-      case InferenceRule::INT_INF_DOWN_INDUCTION_AXIOM:
-        env.statistics->intInfInductionInProof++;
-        break;
-      case InferenceRule::INT_FIN_UP_INDUCTION_AXIOM:
-      case InferenceRule::INT_FIN_DOWN_INDUCTION_AXIOM:
-        env.statistics->intFinInductionInProof++;
-        break;
-      case InferenceRule::INT_DB_UP_INDUCTION_AXIOM:
-      case InferenceRule::INT_DB_DOWN_INDUCTION_AXIOM:
-        env.statistics->intDBInductionInProof++;
-        break;
-      default:
-        ;
-    }
-    switch (rule) {
-      case InferenceRule::INT_INF_UP_INDUCTION_AXIOM:
-        env.statistics->intInfUpInductionInProof++;
-        break;
-      case InferenceRule::INT_INF_DOWN_INDUCTION_AXIOM:
-        env.statistics->intInfDownInductionInProof++;
-        break;
-      case InferenceRule::INT_FIN_UP_INDUCTION_AXIOM:
-        env.statistics->intFinUpInductionInProof++;
-        break;
-      case InferenceRule::INT_FIN_DOWN_INDUCTION_AXIOM:
-        env.statistics->intFinDownInductionInProof++;
-        break;
-      case InferenceRule::INT_DB_UP_INDUCTION_AXIOM:
-        env.statistics->intDBUpInductionInProof++;
-        break;
-      case InferenceRule::INT_DB_DOWN_INDUCTION_AXIOM:
-        env.statistics->intDBDownInductionInProof++;
-        break;
-      default:
-        ;
+    UnitIterator parents=_is->getParents(cs, rule, minimize);
+
+    if (minimize) {
+      cs->inference().updateStatistics(); // in particular, update inductionDepth (which could have decreased, since we might have fewer parents after miniminization)
+      countInProof(rule);
     }
 
     if (cs->isClause()) {
@@ -411,7 +447,7 @@ protected:
   {
     CALL("InferenceStore::ProofPrinter::handleStep");
     InferenceRule rule;
-    UnitIterator parents=_is->getParents(cs, rule);
+    UnitIterator parents=_is->getParents(cs, rule, minimize);
 
     while(parents.hasNext()) {
       Unit* prem=parents.next();
@@ -450,6 +486,8 @@ protected:
 
   bool outputAxiomNames;
   bool delayPrinting;
+  /** false if the premises of SAT based inferences are not to be minimised */
+  bool minimize;
 };
 
 struct InferenceStore::ProofPropertyPrinter
@@ -467,9 +505,8 @@ struct InferenceStore::ProofPropertyPrinter
     last_one = false;
   }
 
-  void print()
+  void printEpilogue()
   {
-    ProofPrinter::print();
     for(unsigned i=0;i<11;i++){ out << buckets[i] << " ";}
     out << endl;
     if(last_one){ out << "yes" << endl; }
@@ -553,12 +590,11 @@ struct InferenceStore::TPTPProofPrinter
     delayPrinting = false;
   }
 
-  void print()
+  void printPrologue()
   {
     //outputSymbolDeclarations also deals with sorts for now
     //UIHelper::outputSortDeclarations(env.out());
     UIHelper::outputSymbolDeclarations(out);
-    ProofPrinter::print();
   }
 
 protected:
@@ -717,7 +753,7 @@ protected:
     CALL("InferenceStore::TPTPProofPrinter::printStep");
 
     InferenceRule rule;
-    UnitIterator parents=_is->getParents(us, rule);
+    UnitIterator parents=_is->getParents(us, rule, minimize);
 
     switch(rule) {
     //case Inference::AVATAR_COMPONENT:
@@ -792,7 +828,7 @@ protected:
     ASS(us->isClause());
 
     InferenceRule rule;
-    UnitIterator parents=_is->getParents(us, rule);
+    UnitIterator parents=_is->getParents(us, rule, minimize);
     ASS(rule==InferenceRule::GENERAL_SPLITTING);
 
     vstring inferenceStr="inference("+tptpRuleName(rule)+",[],[";
@@ -821,7 +857,7 @@ protected:
     ASS(us->isClause());
 
     InferenceRule rule;
-    UnitIterator parents=_is->getParents(us, rule);
+    UnitIterator parents=_is->getParents(us, rule, minimize);
     ASS(!parents.hasNext());
 
     Literal* nameLit=_is->_splittingNameLiterals.get(us); //the name literal must always be stored
@@ -927,7 +963,7 @@ protected:
   {
     CALL("InferenceStore::ProofCheckPrinter::printStep");
     InferenceRule rule;
-    UnitIterator parents=_is->getParents(cs, rule);
+    UnitIterator parents=_is->getParents(cs, rule, minimize);
  
     //outputSymbolDeclarations also deals with sorts for now
     //UIHelper::outputSortDeclarations(out);
@@ -988,9 +1024,8 @@ protected:
     }
   }
 
-  void print()
+  void printEpilogue()
   {
-    ProofPrinter::print();
     out << "%#\n";
   }
 };
@@ -1081,6 +1116,12 @@ void InferenceStore::outputProof(ostream& out, Unit* refutation)
 {
   CALL("InferenceStore::outputProof(ostream&,Unit*)");
 
+  if (InferenceTrace::instance()->enabled()) {
+    // the derivation is not in memory any more, but in the trace
+    InferenceTrace::instance()->outputProof(out, refutation);
+    return;
+  }
+
   ProofPrinter* p = createProofPrinter(out);
   if (!p) {
     return;
@@ -1111,6 +1152,54 @@ void InferenceStore::outputProof(ostream& out, UnitList* units)
   pp->print();
 }
 
+/**
+ * Output the step of @b u alone in the format selected by the proof option,
+ * without minimising its premises (see InferenceTrace)
+ */
+void InferenceStore::outputProofStep(ostream& out, Unit* u)
+{
+  CALL("InferenceStore::outputProofStep");
+
+  ProofPrinter* p = createProofPrinter(out);
+  if (!p) {
+    return;
+  }
+  ScopedPtr<ProofPrinter> pp(p);
+  pp->printSingleStep(u);
+}
+
+/**
+ * Output what comes before the steps of a proof in the format selected
+ * by the proof option (see outputProofStep)
+ */
+void InferenceStore::outputProofPrologue(ostream& out)
+{
+  CALL("InferenceStore::outputProofPrologue");
+
+  ProofPrinter* p = createProofPrinter(out);
+  if (!p) {
+    return;
+  }
+  ScopedPtr<ProofPrinter> pp(p);
+  pp->printPrologue();
+}
+
+/**
+ * Output what comes after the steps of a proof in the format selected
+ * by the proof option (see outputProofStep)
+ */
+void InferenceStore::outputProofEpilogue(ostream& out)
+{
+  CALL("InferenceStore::outputProofEpilogue");
+
+  ProofPrinter* p = createProofPrinter(out);
+  if (!p) {
+    return;
+  }
+  ScopedPtr<ProofPrinter> pp(p);
+  pp->printEpilogue();
+}
+
 InferenceStore* InferenceStore::instance()
 {
   static ScopedPtr<InferenceStore> inst(new InferenceStore());
@@ -80,7 +80,12 @@ public:
   void outputProof(ostream& out, Unit* refutation);
   void outputProof(ostream& out, UnitList* units);
 
-  UnitIterator getParents(Unit* us, InferenceRule& rule);
+  void outputProofStep(ostream& out, Unit* u);
+  void outputProofPrologue(ostream& out);
+  void outputProofEpilogue(ostream& out);
+  static void countInProof(InferenceRule rule);
+
+  UnitIterator getParents(Unit* us, InferenceRule& rule, bool minimize = true);
   UnitIterator getParents(Unit* us);
 
   vstring getUnitIdStr(Unit* cs);
@@ -0,0 +1,277 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file InferenceTrace.cpp
+ * Implements class InferenceTrace.
+ */
+
+#include <algorithm>
+#include <unistd.h>
+
+#include "Lib/DHMap.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/ScopedPtr.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "Clause.hpp"
+#include "Inference.hpp"
+#include "InferenceStore.hpp"
+#include "Unit.hpp"
+
+#include "InferenceTrace.hpp"
+
+namespace Kernel
+{
+
+using namespace std;
+using namespace Lib;
+
+InferenceTrace::InferenceTrace()
+: _fileName(env.options->proofTrace())
+{
+  _enabled = !_fileName.empty();
+}
+
+InferenceTrace* InferenceTrace::instance()
+{
+  static ScopedPtr<InferenceTrace> inst(new InferenceTrace());
+
+  return inst.ptr();
+}
+
+/**
+ * True if the proof search runs in child processes of a portfolio or
+ * batch mode, several of which may be tracing at the same time
+ */
+bool InferenceTrace::runsInChildProcesses()
+{
+  switch (env.options->mode()) {
+  case Options::Mode::CASC:
+  case Options::Mode::CASC_HOL:
+  case Options::Mode::CASC_SAT:
+  case Options::Mode::CASC_LTB:
+  case Options::Mode::PORTFOLIO:
+  case Options::Mode::SMTCOMP:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * Append a record of @b u to the trace file, assuming its premises
+ * are recorded already
+ *
+ * The record consists of the unit number, the inference rule, the number
+ * of premises, the premise numbers and the length of the proof step of
+ * the unit, as printed in the format of the proof option, followed by
+ * that string, all numbers being 32-bit words. The premises are recorded
+ * as they are, SAT based inferences are only minimised for the refutation
+ * itself (see outputProof).
+ */
+void InferenceTrace::writeRecord(Unit* u)
+{
+  CALL("InferenceTrace::writeRecord");
+
+  if (!_file.is_open()) {
+    bool perProcess = runsInChildProcesses();
+    if (perProcess) {
+      // the strategies run in parallel processes, each of them needs a trace of its own
+      _fileName += "." + Int::toString(getpid());
+    }
+    BYPASSING_ALLOCATOR;
+
+    _file.open(_fileName.c_str(), ios::in | ios::out | ios::binary | ios::trunc);
+    if (_file.fail()) {
+      USER_ERROR("Cannot open the proof trace file "+_fileName);
+    }
+    if (perProcess) {
+      // the trace of a strategy is only read back by the process itself,
+      // so its file is gone with the process, however that ends
+      unlink(_fileName.c_str());
+    }
+  }
+
+  static Stack<unsigned> premises;
+  premises.reset();
+  Inference& inf = u->inference();
+  Inference::Iterator iit = inf.iterator();
+  while (inf.hasNext(iit)) {
+    premises.push(inf.next(iit)->number());
+  }
+  vostringstream stepStr;
+  InferenceStore::instance()->outputProofStep(stepStr, u);
+  vstring step = stepStr.str();
+
+  writeWord(u->number());
+  writeWord(static_cast<unsigned>(inf.rule()));
+  writeWord(premises.size());
+  Stack<unsigned>::BottomFirstIterator pit(premises);
+  while (pit.hasNext()) {
+    writeWord(pit.next());
+  }
+  writeWord(step.size());
+  _file.write(step.data(), step.size());
+}
+
+/**
+ * Record @b u and all its (not yet recorded) ancestors in the trace
+ *
+ * Premises are always recorded before the units derived from them.
+ */
+void InferenceTrace::record(Unit* u)
+{
+  CALL("InferenceTrace::record");
+  ASS(_enabled);
+
+  // the flag is true when the premises of the unit were already scheduled
+  static Stack<pair<Unit*,bool>> todo;
+  ASS(todo.isEmpty());
+  todo.push(make_pair(u,false));
+
+  while (todo.isNonEmpty()) {
+    pair<Unit*,bool> curr = todo.pop();
+    if (_recorded.contains(curr.first->number())) {
+      continue;
+    }
+    if (curr.second) {
+      writeRecord(curr.first);
+      _recorded.insert(curr.first->number());
+      continue;
+    }
+    todo.push(make_pair(curr.first,true));
+    Inference& inf = curr.first->inference();
+    Inference::Iterator iit = inf.iterator();
+    while (inf.hasNext(iit)) {
+      Unit* prem = inf.next(iit);
+      if (!_recorded.contains(prem->number())) {
+        todo.push(make_pair(prem,false));
+      }
+    }
+  }
+}
+
+/**
+ * Record @b cl and drop its links to its premises, so that they may be
+ * deleted as soon as nothing else refers to them
+ */
+void InferenceTrace::recordAndDetach(Clause* cl)
+{
+  CALL("InferenceTrace::recordAndDetach");
+
+  record(cl);
+  // the refutation checks of the saturation need these once the premises are gone
+  cl->inference().detachPremises(cl->derivedFromInput(), cl->derivedFromGoalCheck());
+}
+
+bool InferenceTrace::readWord(unsigned& w)
+{
+  return static_cast<bool>(_file.read(reinterpret_cast<char*>(&w), sizeof(w)));
+}
+
+/**
+ * Move to the record of the unit number @b unit in the trace file
+ */
+void InferenceTrace::seekRecord(const DHMap<unsigned,streamoff>& positions, unsigned unit)
+{
+  CALL("InferenceTrace::seekRecord");
+
+  streamoff pos;
+  if (!positions.find(unit, pos)) {
+    USER_ERROR("The proof trace file "+_fileName+" has no record of unit "+Int::toString(unit));
+  }
+  _file.seekg(pos);
+}
+
+/**
+ * Output the proof of @b refutation reconstructed from the trace to @b out
+ *
+ * The trace is scanned once to find where the records are, then the
+ * ancestors of @b refutation are collected and their steps printed in
+ * the order of their numbers.
+ */
+void InferenceTrace::outputProof(ostream& out, Unit* refutation)
+{
+  CALL("InferenceTrace::outputProof");
+  ASS(_enabled);
+
+  // the inference of the refutation may still be subject to minimization
+  refutation->inference().minimizePremises();
+  record(refutation);
+
+  BYPASSING_ALLOCATOR;
+
+  _file.flush();
+  _file.seekg(0);
+
+  // position in the file of the record of each unit
+  DHMap<unsigned,streamoff> positions;
+  unsigned number, rule, premCnt, len;
+  for (;;) {
+    streamoff pos = _file.tellg();
+    if (!readWord(number) || !readWord(rule) || !readWord(premCnt)) {
+      break;
+    }
+    positions.insert(number, pos);
+    _file.seekg(premCnt*sizeof(unsigned), ios::cur);
+    if (!readWord(len)) {
+      break;
+    }
+    _file.seekg(len, ios::cur);
+  }
+  _file.clear();
+
+  Stack<unsigned> proof;
+  DHSet<unsigned> seen;
+  Stack<unsigned> todo;
+  todo.push(refutation->number());
+  seen.insert(refutation->number());
+  while (todo.isNonEmpty()) {
+    unsigned curr = todo.pop();
+    proof.push(curr);
+    seekRecord(positions, curr);
+    ALWAYS(readWord(number));
+    ALWAYS(readWord(rule));
+    ALWAYS(readWord(premCnt));
+    for (unsigned i=0; i<premCnt; i++) {
+      unsigned prem;
+      ALWAYS(readWord(prem));
+      if (seen.insert(prem)) {
+        todo.push(prem);
+      }
+    }
+  }
+
+  std::sort(proof.begin(), proof.end());
+  InferenceStore::instance()->outputProofPrologue(out);
+  vstring step;
+  Stack<unsigned>::BottomFirstIterator pit(proof);
+  while (pit.hasNext()) {
+    seekRecord(positions, pit.next());
+    ALWAYS(readWord(number));
+    ALWAYS(readWord(rule));
+    ALWAYS(readWord(premCnt));
+    if (env.options->proof() == Options::Proof::ON) {
+      // as the proof printer does
+      InferenceStore::countInProof(static_cast<InferenceRule>(rule));
+    }
+    _file.seekg(premCnt*sizeof(unsigned), ios::cur);
+    ALWAYS(readWord(len));
+    step.resize(len);
+    _file.read(&step[0], len);
+    out << step;
+  }
+  InferenceStore::instance()->outputProofEpilogue(out);
+}
+
+}
@@ -0,0 +1,82 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file InferenceTrace.hpp
+ * Defines class InferenceTrace.
+ */
+
+#ifndef __InferenceTrace__
+#define __InferenceTrace__
+
+#include <fstream>
+#include <ostream>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
+#include "Lib/VString.hpp"
+
+namespace Kernel {
+
+using namespace Lib;
+
+/**
+ * Inference trace stored in a file (see the proof_trace option)
+ *
+ * Each recorded unit is appended to the file as a binary record holding
+ * its number, inference rule, the numbers of its premises and the unit
+ * printed as a proof step. Once a unit is recorded, its links to the
+ * premises can be dropped, so that the premises can be deleted as soon
+ * as the proof search does not need them, rather than staying alive for
+ * the sake of a possible proof. The proof is then reconstructed from
+ * the file by outputProof().
+ *
+ * In the portfolio and batch modes, every child process writes its own
+ * trace, to the given file name extended by the process id, which is
+ * removed as soon as it is open and so is gone with the process.
+ */
+class InferenceTrace
+{
+public:
+  CLASS_NAME(InferenceTrace);
+  USE_ALLOCATOR(InferenceTrace);
+
+  static InferenceTrace* instance();
+
+  /** true if the inferences should be traced, i.e. proof_trace is set */
+  bool enabled() const { return _enabled; }
+
+  void record(Unit* u);
+  void recordAndDetach(Clause* cl);
+
+  void outputProof(ostream& out, Unit* refutation);
+
+private:
+  InferenceTrace();
+
+  static bool runsInChildProcesses();
+  void writeRecord(Unit* u);
+  void writeWord(unsigned w) { _file.write(reinterpret_cast<const char*>(&w), sizeof(w)); }
+  bool readWord(unsigned& w);
+  void seekRecord(const DHMap<unsigned,streamoff>& positions, unsigned unit);
+
+  bool _enabled;
+  vstring _fileName;
+  fstream _file;
+
+  /** numbers of the units already in the trace */
+  DHSet<unsigned> _recorded;
+};
+
+}
+
+#endif /* __InferenceTrace__ */
@@ -377,7 +377,7 @@ TermList PolyNf::denormalize() const
         ); }
   };
 
-  static Memo::Hashed<PolyNf, TermList, StlHash> memo;
+  static auto memo = arithmeticMemo<PolyNf, TermList>();
   return evaluateBottomUp(*this, Eval{}, memo);
 }
 
@@ -36,6 +36,8 @@
 #include "Kernel/BottomUpEvaluation/TermList.hpp"
 #include "Kernel/BottomUpEvaluation/PolyNf.hpp"
 #include "Inferences/InferenceEngine.hpp"
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
 
 
 namespace Kernel {
@@ -53,6 +55,19 @@ using NormalizationResult = Coproduct<PolyNf
 
 PolyNf normalizeTerm(TypedTermList t);
 
+/** 
+ * a memo for the arithmetic normalisation that is bounded by --arithmetic_memo_limit 
+ * and reports to the arithmetic memo statistics
+ */
+template<class Arg, class Result>
+Memo::Bounded<Arg, Result, StlHash> arithmeticMemo()
+{ 
+  return Memo::Bounded<Arg, Result, StlHash>(env.options->arithmeticMemoLimit(), 
+      env.statistics->arithmeticMemoHits, 
+      env.statistics->arithmeticMemoMisses, 
+      env.statistics->arithmeticMemoEvictions); 
+}
+
 } // namespace Kernel
 
 #endif // __POLYNOMIAL_NORMALIZER_HPP__
@@ -265,7 +265,7 @@ void Problem::addPartiallyEliminatedPredicate(unsigned pred, Unit* definition)
 /**
  * Recalculate the property from the current set of formulas
  */
-void Problem::refreshProperty() const
+void Problem::refreshProperty(bool findTheories) const
 {
   CALL("Problem::refreshProperty");
 
@@ -276,7 +276,7 @@ void Problem::refreshProperty() const
     delete _property;
   }
   _propertyValid = true;
-  _property = Property::scan(_units);
+  _property = Property::scan(_units,findTheories);
   env.property = _property;
   ASS(_property);
   _property->setSMTLIBLogic(getSMTLIBLogic());
@@ -372,6 +372,21 @@ Property* Problem::getProperty() const
   return _property;
 }
 
+/**
+ * Return property corresponding to the current state of the problem,
+ * with the theory axioms found in it recorded as by TheoryFinder::search().
+ * Both are computed in a single pass over the units.
+ */
+Property* Problem::getPropertyAndTheories() const
+{
+  CALL("Problem::getPropertyAndTheories");
+
+  refreshProperty(true);
+  ASS(_property);
+
+  return _property;
+}
+
 
 bool Problem::hasFormulas() const
 {
@@ -91,6 +91,7 @@ public:
 
   bool isPropertyUpToDate() const { return _propertyValid; }
   Property* getProperty() const;
+  Property* getPropertyAndTheories() const;
   void invalidateProperty() { _propertyValid = false; }
 
   void invalidateByRemoval();
@@ -187,7 +188,7 @@ private:
 
   void initValues();
 
-  void refreshProperty() const;
+  void refreshProperty(bool findTheories=false) const;
   void readDetailsFromProperty() const;
 
   UnitList* _units;
@@ -19,6 +19,8 @@
 
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
+#include "Lib/BitUtils.hpp"
+#include "Lib/STL.hpp"
 
 #include "Shell/Skolem.hpp"
 
@@ -29,46 +31,358 @@
 #include "Kernel/NumTraits.hpp"
 
 #include "Theory.hpp"
-#define USES_2_COMPLEMENT (~0 == -1)
 
 namespace Kernel
 {
 
 using namespace Lib;
 
+///////////////////////
+// BigInteger
+//
+
+/**
+ * An integer that does not fit into IntegerConstantType::InnerType, as a sign and a
+ * magnitude in base 2^32 (least significant digit first, without leading zero digits).
+ *
+ * The values referenced by IntegerConstantType are interned, i.e. there is a single
+ * BigInteger for each value and it is never freed (like shared terms). This keeps
+ * IntegerConstantType trivially copyable and makes equality a pointer comparison.
+ * Temporary values used during a computation are not interned.
+ */
+class BigInteger
+{
+public:
+  typedef vvector<unsigned> Digits;
+
+  BigInteger() : negative(false) {}
+  explicit BigInteger(long long val) : negative(val < 0)
+  {
+    unsigned long long mag = negative ? 0ull - (unsigned long long)val : val;
+    while (mag) {
+      digits.push_back((unsigned)mag);
+      mag >>= 32;
+    }
+  }
+
+  bool negative;
+  Digits digits;
+
+  bool isZero() const { return digits.empty(); }
+
+  void trim()
+  {
+    while (!digits.empty() && !digits.back()) {
+      digits.pop_back();
+    }
+    if (digits.empty()) {
+      negative = false;
+    }
+  }
+
+  /** true if the value fits into IntegerConstantType::InnerType; the value is then stored in @b res */
+  bool fitsInner(IntegerConstantType::InnerType& res) const
+  {
+    if (digits.size() > 1) {
+      return false;
+    }
+    long long val = digits.empty() ? 0 : (long long)digits[0];
+    if (negative) {
+      val = -val;
+    }
+    if (val < numeric_limits<IntegerConstantType::InnerType>::min() || val > numeric_limits<IntegerConstantType::InnerType>::max()) {
+      return false;
+    }
+    res = (IntegerConstantType::InnerType)val;
+    return true;
+  }
+
+  bool operator==(const BigInteger& o) const
+  { return negative == o.negative && digits == o.digits; }
+
+  struct Hash
+  {
+    size_t operator()(const BigInteger& b) const
+    {
+      size_t res = b.negative;
+      for (unsigned d : b.digits) {
+        res = res * 1000003 ^ d;
+      }
+      return res;
+    }
+  };
+
+  /** the unique interned instance equal to @b val */
+  static const BigInteger* intern(BigInteger&& val)
+  {
+    static vunordered_set<BigInteger, Hash> interned;
+    return &*interned.insert(std::move(val)).first;
+  }
+
+  static int compareMagnitude(const Digits& a, const Digits& b)
+  {
+    if (a.size() != b.size()) {
+      return a.size() < b.size() ? -1 : 1;
+    }
+    for (size_t i = a.size(); i-- > 0;) {
+      if (a[i] != b[i]) {
+        return a[i] < b[i] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  static Digits addMagnitude(const Digits& a, const Digits& b)
+  {
+    Digits res;
+    unsigned long long carry = 0;
+    for (size_t i = 0; i < a.size() || i < b.size() || carry; i++) {
+      carry += i < a.size() ? a[i] : 0;
+      carry += i < b.size() ? b[i] : 0;
+      res.push_back((unsigned)carry);
+      carry >>= 32;
+    }
+    return res;
+  }
+
+  /** @b a - @b b, where |a| >= |b| */
+  static Digits subtractMagnitude(const Digits& a, const Digits& b)
+  {
+    ASS_GE(compareMagnitude(a, b), 0);
+    Digits res;
+    long long borrow = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+      long long diff = (long long)a[i] - (i < b.size() ? b[i] : 0) - borrow;
+      borrow = diff < 0;
+      res.push_back((unsigned)(diff + (borrow << 32)));
+    }
+    while (!res.empty() && !res.back()) {
+      res.pop_back();
+    }
+    return res;
+  }
+
+  static BigInteger add(const BigInteger& a, const BigInteger& b)
+  {
+    BigInteger res;
+    if (a.negative == b.negative) {
+      res.negative = a.negative;
+      res.digits = addMagnitude(a.digits, b.digits);
+    } else if (compareMagnitude(a.digits, b.digits) >= 0) {
+      res.negative = a.negative;
+      res.digits = subtractMagnitude(a.digits, b.digits);
+    } else {
+      res.negative = b.negative;
+      res.digits = subtractMagnitude(b.digits, a.digits);
+    }
+    res.trim();
+    return res;
+  }
+
+  static BigInteger multiply(const BigInteger& a, const BigInteger& b)
+  {
+    BigInteger res;
+    res.negative = a.negative != b.negative;
+    res.digits.resize(a.digits.size() + b.digits.size(), 0);
+    for (size_t i = 0; i < a.digits.size(); i++) {
+      unsigned long long carry = 0;
+      for (size_t j = 0; j < b.digits.size() || carry; j++) {
+        unsigned long long cur = res.digits[i + j] + carry
+          + (j < b.digits.size() ? (unsigned long long)a.digits[i] * b.digits[j] : 0);
+        res.digits[i + j] = (unsigned)cur;
+        carry = cur >> 32;
+      }
+    }
+    res.trim();
+    return res;
+  }
+
+  /** 
+   * Truncating division (the quotient is rounded towards zero, the remainder has the sign of @b a).
+   * Binary long division: numbers that do not fit into a machine integer are rare, and small 
+   * when they occur, so simplicity wins over speed here.
+   */
+  static void divide(const BigInteger& a, const BigInteger& b, BigInteger& quot, BigInteger& rem)
+  {
+    ASS(!b.isZero());
+    quot = BigInteger();
+    rem = BigInteger();
+    quot.digits.resize(a.digits.size(), 0);
+    for (size_t i = a.digits.size() * 32; i-- > 0;) {
+      // rem = rem * 2 + bit i of a
+      unsigned carry = (a.digits[i / 32] >> (i % 32)) & 1;
+      for (size_t j = 0; j < rem.digits.size(); j++) {
+        unsigned next = rem.digits[j] >> 31;
+        rem.digits[j] = (rem.digits[j] << 1) | carry;
+        carry = next;
+      }
+      if (carry) {
+        rem.digits.push_back(carry);
+      }
+      if (compareMagnitude(rem.digits, b.digits) >= 0) {
+        rem.digits = subtractMagnitude(rem.digits, b.digits);
+        quot.digits[i / 32] |= 1u << (i % 32);
+      }
+    }
+    quot.negative = a.negative != b.negative;
+    rem.negative = a.negative;
+    quot.trim();
+    rem.trim();
+  }
+
+  static bool parse(const vstring& str, BigInteger& res)
+  {
+    size_t i = 0;
+    res = BigInteger();
+    bool negative = !str.empty() && str[0] == '-';
+    if (negative || (!str.empty() && str[0] == '+')) {
+      i++;
+    }
+    if (i == str.size()) {
+      return false;
+    }
+    for (; i < str.size(); i++) {
+      if (str[i] < '0' || str[i] > '9') {
+        return false;
+      }
+      // res = res * 10 + digit
+      unsigned long long carry = str[i] - '0';
+      for (size_t j = 0; j < res.digits.size(); j++) {
+        carry += (unsigned long long)res.digits[j] * 10;
+        res.digits[j] = (unsigned)carry;
+        carry >>= 32;
+      }
+      if (carry) {
+        res.digits.push_back((unsigned)carry);
+      }
+    }
+    res.negative = negative;
+    res.trim();
+    return true;
+  }
+
+  vstring toString() const
+  {
+    if (isZero()) {
+      return "0";
+    }
+    // split off 9 decimal digits at a time
+    Digits mag = digits;
+    vstring res;
+    while (!mag.empty()) {
+      unsigned long long rem = 0;
+      for (size_t i = mag.size(); i-- > 0;) {
+        unsigned long long cur = (rem << 32) | mag[i];
+        mag[i] = (unsigned)(cur / 1000000000);
+        rem = cur % 1000000000;
+      }
+      while (!mag.empty() && !mag.back()) {
+        mag.pop_back();
+      }
+      for (unsigned k = 0; k < 9 && (rem || !mag.empty()); k++) {
+        res += (char)('0' + rem % 10);
+        rem /= 10;
+      }
+    }
+    if (negative) {
+      res += '-';
+    }
+    return vstring(res.rbegin(), res.rend());
+  }
+};
+
 ///////////////////////
 // IntegerConstantType
 //
 
 IntegerConstantType::IntegerConstantType(const vstring& str)
+  : _val(0), _big(nullptr)
 {
   CALL("IntegerConstantType::IntegerConstantType(vstring)");
 
-  if (!Int::stringToInt(str, _val)) {
+  if (Int::stringToInt(str, _val)) {
+    return;
+  }
+  BigInteger big;
+  if (!BigInteger::parse(str, big)) {
     throw MachineArithmeticException();
   }
+  *this = IntegerConstantType(big);
 }
 
-IntegerConstantType IntegerConstantType::operator+(const IntegerConstantType& num) const
+/** Normalises @b big to the unique representation of its value */
+IntegerConstantType::IntegerConstantType(const BigInteger& big)
+  : _val(0), _big(nullptr)
 {
-  CALL("IntegerConstantType::operator+");
+  if (!big.fitsInner(_val)) {
+    _big = BigInteger::intern(BigInteger(big));
+  }
+}
 
-  InnerType res;
-  if (!Int::safePlus(_val, num._val, res)) {
+BigInteger IntegerConstantType::toBig() const
+{ return _big ? *_big : BigInteger(_val); }
+
+double IntegerConstantType::toDouble() const
+{
+  if (!_big) {
+    return _val;
+  }
+  double res = 0;
+  for (size_t i = _big->digits.size(); i-- > 0;) {
+    res = res * 4294967296.0 + _big->digits[i];
+  }
+  return _big->negative ? -res : res;
+}
+
+IntegerConstantType::InnerType IntegerConstantType::toInner() const
+{
+  if (_big) {
     throw MachineArithmeticException();
   }
-  return IntegerConstantType(res);
+  return _val;
 }
 
-IntegerConstantType IntegerConstantType::operator-(const IntegerConstantType& num) const
+bool IntegerConstantType::isNegative() const
+{ return _big ? _big->negative : _val < 0; }
+
+unsigned IntegerConstantType::log2Abs() const
 {
-  CALL("IntegerConstantType::operator-/1");
+  if (!_big) {
+    return BitUtils::log2(Int::safeAbs(_val));
+  }
+  return (_big->digits.size() - 1) * 32 + BitUtils::log2(_big->digits.back());
+}
 
-  InnerType res;
-  if (!Int::safeMinus(_val, num._val, res)) {
-    throw MachineArithmeticException();
+IntegerConstantType IntegerConstantType::bigPlus(const IntegerConstantType& num) const
+{
+  CALL("IntegerConstantType::bigPlus");
+  return IntegerConstantType(BigInteger::add(toBig(), num.toBig()));
+}
+
+IntegerConstantType IntegerConstantType::bigMinus(const IntegerConstantType& num) const
+{
+  CALL("IntegerConstantType::bigMinus");
+  BigInteger negated = num.toBig();
+  negated.negative = !negated.negative;
+  negated.trim();
+  return IntegerConstantType(BigInteger::add(toBig(), negated));
+}
+
+IntegerConstantType IntegerConstantType::bigMultiply(const IntegerConstantType& num) const
+{
+  CALL("IntegerConstantType::bigMultiply");
+  return IntegerConstantType(BigInteger::multiply(toBig(), num.toBig()));
+}
+
+int IntegerConstantType::bigCompare(const IntegerConstantType& num) const
+{
+  BigInteger a = toBig();
+  BigInteger b = num.toBig();
+  if (a.negative != b.negative) {
+    return a.negative ? -1 : 1;
   }
-  return IntegerConstantType(res);
+  int cmp = BigInteger::compareMagnitude(a.digits, b.digits);
+  return a.negative ? -cmp : cmp;
 }
 
 IntegerConstantType IntegerConstantType::operator-() const
@@ -76,52 +390,62 @@ IntegerConstantType IntegerConstantType::operator-() const
   CALL("IntegerConstantType::operator-/0");
 
   InnerType res;
-  if (!Int::safeUnaryMinus(_val, res)) {
-    throw MachineArithmeticException();
+  if (!_big && Int::safeUnaryMinus(_val, res)) {
+    return IntegerConstantType(res);
   }
-  return IntegerConstantType(res);
+  BigInteger negated = toBig();
+  negated.negative = !negated.negative;
+  return IntegerConstantType(negated);
 }
 
-IntegerConstantType IntegerConstantType::operator*(const IntegerConstantType& num) const
+/** 
+ * Truncating division, i.e. the C++ semantics of / and %.
+ */
+void IntegerConstantType::divideT(const IntegerConstantType& num, IntegerConstantType& quot, IntegerConstantType& rem) const
 {
-  CALL("IntegerConstantType::operator*");
+  CALL("IntegerConstantType::divideT");
 
-  InnerType res;
-  if (!Int::safeMultiply(_val, num._val, res)) {
-    throw MachineArithmeticException();
+  if (num.isZero()) {
+    throw DivByZeroException();
   }
-  return IntegerConstantType(res);
-}
-
-inline typename IntegerConstantType::InnerType divideOrThrow(typename IntegerConstantType::InnerType lhs, typename IntegerConstantType::InnerType rhs) {
-    typename IntegerConstantType::InnerType out;
-    if (!Int::safeDivide(lhs,rhs, out))
-      throw MachineArithmeticException();
-    return out;
+  if (!_big && !num._big && !(_val == numeric_limits<InnerType>::min() && num._val == -1)) {
+    quot = IntegerConstantType(_val / num._val);
+    rem = IntegerConstantType(_val % num._val);
+    return;
+  }
+  BigInteger q, r;
+  BigInteger::divide(toBig(), num.toBig(), q, r);
+  quot = IntegerConstantType(q);
+  rem = IntegerConstantType(r);
 }
 
-int IntegerConstantType::intDivide(const IntegerConstantType& num) const 
+IntegerConstantType IntegerConstantType::intDivide(const IntegerConstantType& num) const 
 {
     CALL("IntegerConstantType::intDivide");
     ASS_REP(num.divides(*this),  num.toString() + " does not divide " + this->toString() );
-    return divideOrThrow(_val, num._val);
+    IntegerConstantType quot, rem;
+    divideT(num, quot, rem);
+    return quot;
+}
+
+float IntegerConstantType::realDivide(const IntegerConstantType& num) const
+{
+  if (num.isZero()) throw DivByZeroException();
+  return (float)(toDouble() / num.toDouble());
 }
 
 IntegerConstantType IntegerConstantType::remainderE(const IntegerConstantType& num) const
 {
   CALL("IntegerConstantType::remainderE");
 
-  if (num._val == 0) {
+  if (num.isZero()) {
     throw MachineArithmeticException();
   }
 
-  if (this->_val == numeric_limits<IntegerConstantType::InnerType>::min() && num._val == -1) {
-    return 0;
-  }
-
-  auto mod = IntegerConstantType(this->_val % num._val);
+  IntegerConstantType quot, mod;
+  divideT(num, quot, mod);
   if (mod < 0) {
-    if (num._val >= 0) {
+    if (num >= 0) {
       mod = mod + num;
     } else {
       mod = mod - num;
@@ -145,9 +469,7 @@ RealConstantType RealConstantType::abs() const
 
 IntegerConstantType IntegerConstantType::abs() const
 {
-  if (toInner() == std::numeric_limits<InnerType>::min() && USES_2_COMPLEMENT)
-    throw new MachineArithmeticException();
-  return IntegerConstantType(::std::abs(toInner()));
+  return isNegative() ? -*this : *this;
 }
 
 /**
@@ -158,65 +480,44 @@ IntegerConstantType IntegerConstantType::quotientE(const IntegerConstantType& nu
 { 
   CALL("IntegerConstantType::quotientE");
 
-  if (num._val == 0) {
-    throw DivByZeroException();
-  }
-
-  if (this->_val == numeric_limits<IntegerConstantType::InnerType>::min() && num._val == -1) {
-    throw MachineArithmeticException();
-  }
-
-  // as in remainderE
-  auto mod = IntegerConstantType(this->_val % num._val);
-
-  // return (*this - this->remainderE(num)).intDivide(num); // the clean definition; but we don't want to subtract for small *this
-
+  IntegerConstantType quot, mod;
+  divideT(num, quot, mod);
+  // the truncated quotient is one too close to zero if the remainder is negative
   if (mod < 0) {
-    // as in remainderE -- effectively adjust for the computation of the positive mod
-    if (num._val >= 0) {
-      return (*this - mod).intDivide(num)-1;
-    } else {
-      return (*this - mod).intDivide(num)+1;
-    }
-  } else {
-    if (*this < 0) { // we don't want to subtract a positive mod, counterbalance with num, adjusting with +/-1
-      if (num._val >= 0) {
-        return (*this + num - mod).intDivide(num)-1;
-      } else {
-        return (*this - num - mod).intDivide(num)+1;
-      }
-    } else {
-      return (*this - mod).intDivide(num);
-    }
+    return num >= 0 ? quot - 1 : quot + 1;
   }
+  return quot;
 }
 
 IntegerConstantType IntegerConstantType::quotientF(const IntegerConstantType& num) const
 { 
-  if(num.divides(*this)){
-    return IntegerConstantType(intDivide(num));
+  CALL("IntegerConstantType::quotientF");
+
+  IntegerConstantType quot, mod;
+  divideT(num, quot, mod);
+  // the truncated quotient is one too big if the exact one is negative
+  if (!mod.isZero() && isNegative() != num.isNegative()) {
+    return quot - 1;
   }
-  return IntegerConstantType(::floor(realDivide(num)));
+  return quot;
 }
 
 IntegerConstantType IntegerConstantType::quotientT(const IntegerConstantType& num) const
 { 
-  if(num.divides(*this)){
-    return IntegerConstantType(intDivide(num));
-  }
-  return IntegerConstantType(::trunc(realDivide(num)));
+  CALL("IntegerConstantType::quotientT");
+
+  IntegerConstantType quot, mod;
+  divideT(num, quot, mod);
+  return quot;
 }
 
 bool IntegerConstantType::divides(const IntegerConstantType& num) const 
 {
   CALL("IntegerConstantType:divides");
-  if (_val == 0) { return false; }
-  if (num._val == _val) { return true; }
-  if (num._val == numeric_limits<decltype(num._val)>::min() && _val == -1) {
-    return true;
-  } else {
-    return ( num._val % _val == 0);
-  }
+  if (isZero()) { return false; }
+  IntegerConstantType quot, mod;
+  num.divideT(*this, quot, mod);
+  return mod.isZero();
 }
 
 //TODO remove this operator. We already have 3 other ways of computing the remainder, required by the semantics of TPTP and SMTCOMP.
@@ -225,24 +526,32 @@ IntegerConstantType IntegerConstantType::operator%(const IntegerConstantType& nu
   CALL("IntegerConstantType::operator%");
 
   //TODO: check if modulo corresponds to the TPTP semantic
-  if (num._val==0) {
-    throw DivByZeroException();
-  }
-  return IntegerConstantType(_val%num._val);
-}
-
-bool IntegerConstantType::operator==(const IntegerConstantType& num) const
-{
-  CALL("IntegerConstantType::operator==");
-
-  return _val==num._val;
+  IntegerConstantType quot, mod;
+  divideT(num, quot, mod);
+  return mod;
 }
 
-bool IntegerConstantType::operator>(const IntegerConstantType& num) const
+IntegerConstantType IntegerConstantType::gcd(IntegerConstantType n1, IntegerConstantType n2)
 {
-  CALL("IntegerConstantType::operator>");
+  CALL("IntegerConstantType::gcd");
 
-  return _val>num._val;
+  if (n1.isSmall() && n2.isSmall()) {
+    unsigned res = Int::gcd(n1._val, n2._val);
+    if (res <= (unsigned)numeric_limits<InnerType>::max()) {
+      return IntegerConstantType((InnerType)res);
+    }
+  }
+  n1 = n1.abs();
+  n2 = n2.abs();
+  if (n1.isZero() && n2.isZero()) {
+    return IntegerConstantType(1);
+  }
+  while (!n2.isZero()) {
+    IntegerConstantType rem = n1 % n2;
+    n1 = n2;
+    n2 = rem;
+  }
+  return n1;
 }
 
 IntegerConstantType IntegerConstantType::floor(IntegerConstantType x)
@@ -252,18 +561,8 @@ IntegerConstantType IntegerConstantType::floor(RationalConstantType rat)
 {
   CALL("IntegerConstantType::floor");
 
-  IntegerConstantType num = rat.numerator();
-  IntegerConstantType den = rat.denominator();
-  if (den == IntegerConstantType(1)) {
-    return num;
-  }
-  /* there is a non-zero remainder for num / den */
-  ASS_G(den, 0);
-  if (num >= IntegerConstantType(0)) {
-    return IntegerConstantType(num.toInner() /den.toInner());
-  } else  {
-    return IntegerConstantType(num.toInner() / den.toInner() - 1);
-  }
+  ASS_G(rat.denominator(), 0);
+  return rat.numerator().quotientF(rat.denominator());
 }
 
 IntegerConstantType IntegerConstantType::ceiling(IntegerConstantType x)
@@ -284,50 +583,36 @@ IntegerConstantType IntegerConstantType::ceiling(RationalConstantType rat)
   }
   /* there is a remainder for num / den */
   ASS_G(den, 0);
-  if (num >= IntegerConstantType(0)) {
-    return IntegerConstantType(num.toInner() /den.toInner() + 1);
-  } else  {
-    return IntegerConstantType(num.toInner() / den.toInner());
-  }
+  return num.quotientF(den) + 1;
 }
 
+/**
+ * Numbers with a smaller absolute value are smaller, of two numbers with the same
+ * absolute value the negative one is greater.
+ */
 Comparison IntegerConstantType::comparePrecedence(IntegerConstantType n1, IntegerConstantType n2)
 {
   CALL("IntegerConstantType::comparePrecedence");
-  try {
-    if (n1 == numeric_limits<InnerType>::min()) {
-      if (n2 == numeric_limits<InnerType>::min()) {
-        return EQUAL;
-      } else {
-        return GREATER;
-      }
-    } else {
-      if (n2 == numeric_limits<InnerType>::min()) {
-        return LESS;
-      } else {
-        InnerType an1 = n1.abs().toInner();
-        InnerType an2 = n2.abs().toInner();
-
-        ASS_GE(an1,0);
-        ASS_GE(an2,0);
 
-        return an1 < an2 ? LESS : (an1 == an2 ? // compare the signed ones, making negative greater than positive
-            static_cast<Comparison>(-Int::compare(n1.toInner(), n2.toInner()))
-                              : GREATER);
-      }
-    }
+  if (n1.isSmall() && n2.isSmall()) {
+    unsigned an1 = Int::safeAbs(n1._val);
+    unsigned an2 = Int::safeAbs(n2._val);
+    return an1 < an2 ? LESS : (an1 == an2 ? // compare the signed ones, making negative greater than positive
+        static_cast<Comparison>(-Int::compare(n1._val, n2._val))
+                          : GREATER);
   }
-  catch(ArithmeticException&) {
-    ASSERTION_VIOLATION;
-    throw;
+  int cmp = n1.abs().bigCompare(n2.abs());
+  if (cmp != 0) {
+    return cmp < 0 ? LESS : GREATER;
   }
+  return static_cast<Comparison>(-n1.bigCompare(n2));
 }
 
 vstring IntegerConstantType::toString() const
 {
   CALL("IntegerConstantType::toString");
 
-  return Int::toString(_val);
+  return _big ? _big->toString() : Int::toString(_val);
 }
 
 ///////////////////////
@@ -357,7 +642,7 @@ void RationalConstantType::init(InnerType num, InnerType den)
   cannonize();
 
   // Dividing by zero is bad!
-  if(_den.toInner()==0) throw DivByZeroException();
+  if(_den.isZero()) throw DivByZeroException();
 }
 
 RationalConstantType RationalConstantType::operator+(const RationalConstantType& o) const
@@ -418,11 +703,8 @@ bool RationalConstantType::operator==(const RationalConstantType& o) const
 bool RationalConstantType::operator>(const RationalConstantType& o) const
 {
   CALL("IntegerConstantType::operator>");
-  /* prevents overflows */
-  auto toLong = [](IntegerConstantType t)  -> long int
-  { return  t.toInner(); };
 
-  return toLong(_num)*toLong(o._den)>(toLong(o._num)*toLong(_den));
+  return _num*o._den > o._num*_den;
 }
 
 
@@ -445,17 +727,7 @@ void RationalConstantType::cannonize()
 {
   CALL("RationalConstantType::cannonize");
 
-  unsigned gcd = Int::gcd(_num.toInner(), _den.toInner());
-  if (gcd == (unsigned)(-(long long)(numeric_limits<int>::min()))) { // we are talking about 2147483648, but I can't take minus of it's int representation!
-    ASS_EQ(_num, numeric_limits<int>::min());
-    ASS_EQ(_den, numeric_limits<int>::min());
-    _num = 1;
-    _den = 1;
-    return;
-  }
-
-  // now it's safe to treat this unsigned as signed
-  ASS_LE(gcd,(unsigned)numeric_limits<signed>::max());
+  IntegerConstantType gcd = IntegerConstantType::gcd(_num, _den);
   if (gcd!=1) {
     _num = _num.intDivide(gcd);
     _den = _den.intDivide(gcd);
@@ -628,10 +900,10 @@ vstring RealConstantType::toNiceString() const
 {
   CALL("RealConstantType::toNiceString");
 
-  if (denominator().toInner()==1) {
+  if (denominator()==1) {
     return numerator().toString()+".0";
   }
-  float frep = (float) numerator().toInner() /(float) denominator().toInner();
+  float frep = numerator().realDivide(denominator());
   return Int::toString(frep);
   //return toString();
 }
@@ -2207,7 +2479,7 @@ vstring Theory::tryGetInterpretedLaTeXName(unsigned func, bool pred,bool polarit
 }
 
 size_t IntegerConstantType::hash() const {
-  return std::hash<decltype(_val)>{}(_val);
+  return _big ? BigInteger::Hash()(*_big) : std::hash<decltype(_val)>{}(_val);
 }
 
 size_t RationalConstantType::hash() const {
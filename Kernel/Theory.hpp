@@ -29,6 +29,7 @@
 
 namespace Kernel {
 
+class BigInteger;
 class IntegerConstantType;
 struct RationalConstantType;
 class RealConstantType;
@@ -54,6 +55,14 @@ public:
   DivByZeroException() : ArithmeticException("divided by zero"){} 
 };
 
+/**
+ * A class for representing integers of arbitrary size.
+ *
+ * Values that fit into a machine int are stored directly and use overflow-checked
+ * machine arithmetic. Only if an operation overflows, the result is stored as a
+ * BigInteger (see Theory.cpp). Every value has exactly one representation, so a value
+ * that fits into InnerType is never a BigInteger.
+ */
 class IntegerConstantType
 {
 public:
@@ -62,25 +71,44 @@ public:
 
   typedef int InnerType;
 
-  IntegerConstantType() {}
+  IntegerConstantType() : _val(0), _big(nullptr) {}
   IntegerConstantType(IntegerConstantType&&) = default;
   IntegerConstantType(const IntegerConstantType&) = default;
   IntegerConstantType& operator=(const IntegerConstantType&) = default;
-  constexpr IntegerConstantType(InnerType v) : _val(v) {}
+  constexpr IntegerConstantType(InnerType v) : _val(v), _big(nullptr) {}
   explicit IntegerConstantType(const vstring& str);
 
-  IntegerConstantType operator+(const IntegerConstantType& num) const;
-  IntegerConstantType operator-(const IntegerConstantType& num) const;
+  IntegerConstantType operator+(const IntegerConstantType& num) const
+  {
+    InnerType res;
+    if (!_big && !num._big && !__builtin_add_overflow(_val, num._val, &res)) {
+      return IntegerConstantType(res);
+    }
+    return bigPlus(num);
+  }
+  IntegerConstantType operator-(const IntegerConstantType& num) const
+  {
+    InnerType res;
+    if (!_big && !num._big && !__builtin_sub_overflow(_val, num._val, &res)) {
+      return IntegerConstantType(res);
+    }
+    return bigMinus(num);
+  }
   IntegerConstantType operator-() const;
-  IntegerConstantType operator*(const IntegerConstantType& num) const;
+  IntegerConstantType operator*(const IntegerConstantType& num) const
+  {
+    InnerType res;
+    if (!_big && !num._big && !__builtin_mul_overflow(_val, num._val, &res)) {
+      return IntegerConstantType(res);
+    }
+    return bigMultiply(num);
+  }
 
   // true if this divides num
   bool divides(const IntegerConstantType& num) const ;
-  float realDivide(const IntegerConstantType& num) const { 
-    if(num._val==0) throw DivByZeroException();
-    return ((float)_val)/num._val; 
-  }
-  int intDivide(const IntegerConstantType& num) const ;  
+  float realDivide(const IntegerConstantType& num) const;
+  /** divides by @b num, which must divide this number */
+  IntegerConstantType intDivide(const IntegerConstantType& num) const ;  
   IntegerConstantType remainderE(const IntegerConstantType& num) const; 
   IntegerConstantType quotientE(const IntegerConstantType& num) const; 
   IntegerConstantType quotientT(const IntegerConstantType& num) const;
@@ -91,18 +119,25 @@ public:
   IntegerConstantType remainderF(const IntegerConstantType& num) const
   { return (*this) - num * quotientF(num); } 
 
-  bool operator==(const IntegerConstantType& num) const;
-  bool operator>(const IntegerConstantType& num) const;
+  bool operator==(const IntegerConstantType& num) const
+  { return _val == num._val && _big == num._big; }
+  bool operator>(const IntegerConstantType& num) const
+  { return (_big || num._big) ? bigCompare(num) > 0 : _val > num._val; }
 
   bool operator!=(const IntegerConstantType& num) const { return !((*this)==num); }
   bool operator<(const IntegerConstantType& o) const { return o>(*this); }
   bool operator>=(const IntegerConstantType& o) const { return !(o>(*this)); }
   bool operator<=(const IntegerConstantType& o) const { return !((*this)>o); }
 
-  InnerType toInner() const { return _val; }
+  /** true if the value fits into InnerType */
+  bool isSmall() const { return !_big; }
+  /** the value as a machine integer, throws MachineArithmeticException if it does not fit into one */
+  InnerType toInner() const;
 
-  bool isZero(){ return _val==0; }
-  bool isNegative(){ return _val<0; }
+  bool isZero() const { return !_big && _val==0; }
+  bool isNegative() const;
+  /** floor(log2(|n|)), 0 for 0 */
+  unsigned log2Abs() const;
 
   static IntegerConstantType floor(RationalConstantType rat);
   static IntegerConstantType floor(IntegerConstantType rat);
@@ -110,20 +145,34 @@ public:
   static IntegerConstantType ceiling(RationalConstantType rat);
   static IntegerConstantType ceiling(IntegerConstantType rat);
   IntegerConstantType abs() const;
+  /** the greatest common divisor of @b n1 and @b n2 (1 if both are 0) */
+  static IntegerConstantType gcd(IntegerConstantType n1, IntegerConstantType n2);
 
   static Comparison comparePrecedence(IntegerConstantType n1, IntegerConstantType n2);
   size_t hash() const;
 
   vstring toString() const;
 private:
+  /** the value if _big is null, 0 otherwise */
   InnerType _val;
+  /** the interned value if it does not fit into InnerType */
+  const BigInteger* _big;
+
+  explicit IntegerConstantType(const BigInteger& big);
+  BigInteger toBig() const;
+  double toDouble() const;
+  IntegerConstantType bigPlus(const IntegerConstantType& num) const;
+  IntegerConstantType bigMinus(const IntegerConstantType& num) const;
+  IntegerConstantType bigMultiply(const IntegerConstantType& num) const;
+  int bigCompare(const IntegerConstantType& num) const;
+  void divideT(const IntegerConstantType& num, IntegerConstantType& quot, IntegerConstantType& rem) const;
   IntegerConstantType operator/(const IntegerConstantType& num) const;
   IntegerConstantType operator%(const IntegerConstantType& num) const;
 };
 
 inline
 std::ostream& operator<< (ostream& out, const IntegerConstantType& val) {
-  return out << val.toInner();
+  return out << val.toString();
 }
 
 /**
@@ -174,10 +223,10 @@ struct RationalConstantType {
   bool operator>=(const RationalConstantType& o) const { return !(o>(*this)); }
   bool operator<=(const RationalConstantType& o) const { return !((*this)>o); }
 
-  bool isZero(){ return _num.toInner()==0; } 
+  bool isZero(){ return _num.isZero(); } 
   // relies on the fact that cannonize ensures that _den>=0
-  bool isNegative() const { ASS(_den>=0); return _num.toInner() < 0; }
-  bool isPositive() const { ASS(_den>=0); return _num.toInner() > 0; }
+  bool isNegative() const { ASS(_den>=0); return _num.isNegative(); }
+  bool isPositive() const { ASS(_den>=0); return _num > 0; }
 
   RationalConstantType abs() const;
 
@@ -227,7 +227,7 @@ bool Unit::derivedFromInput() const
   todo.push(&const_cast<Inference&>(_inference)); 
   while(!todo.isEmpty()){
     Inference* inf = todo.pop();
-    if(inf->rule() == InferenceRule::INPUT){
+    if(inf->rule() == InferenceRule::INPUT || inf->detachedFromInput()){
       return true;
     }
     Inference::Iterator it = inf->iterator();
@@ -251,7 +251,7 @@ bool Unit::derivedFromGoalCheck() const
   InferenceList::push(&const_cast<Inference&>(_inference),todo);
   while(!InferenceList::isEmpty(todo)){
     Inference* inf = InferenceList::pop(todo);
-    if(inf->derivedFromGoal()) {
+    if(inf->derivedFromGoal() || inf->detachedFromGoal()) {
       return true;
     }
     Inference::Iterator it = inf->iterator();
@@ -23,6 +23,8 @@
 
 #include <cstring>
 #include <cstdlib>
+#include <cstdio>
+#include <sys/mman.h>
 #include "Lib/System.hpp"
 #include "Lib/Timer.hpp"
 #include "Shell/UIHelper.hpp"
@@ -95,6 +97,12 @@ size_t Allocator::_tolerated;
 Allocator* Allocator::current;
 Allocator::Page* Allocator::_pages[MAX_PAGES];
 size_t Allocator::_usedMemory = 0;
+bool Allocator::_hugePages = false;
+Allocator::HugeRegion* Allocator::_hugeRegions = 0;
+char* Allocator::_hugeRegionFree = 0;
+size_t Allocator::_hugeRegionFreeBytes = 0;
+size_t Allocator::_hugeRegionCount = 0;
+size_t Allocator::_hugeRegionBytes = 0;
 Allocator* Allocator::_all[MAX_ALLOCATORS];
 
 #if VDEBUG
@@ -316,7 +324,9 @@ void Allocator::cleanup()
       _pages[i] = pg->next;
       
       char* mem = reinterpret_cast<char*>(pg);
-      free(mem);
+      if (!inHugeRegion(mem)) {
+        free(mem);
+      }
 #if VDEBUG && TRACE_ALLOCATIONS
       cnt++;
 #endif    
@@ -327,6 +337,14 @@ void Allocator::cleanup()
       }
 #endif        
   }
+  // the pages carved from huge page regions go away with their regions
+  while (_hugeRegions) {
+    HugeRegion* region = _hugeRegions;
+    _hugeRegions = region->next;
+    munmap(region, region->size);
+  }
+  _hugeRegionFree = 0;
+  _hugeRegionFreeBytes = 0;
     
 #if VDEBUG
   delete[] Descriptor::map;
@@ -623,7 +641,7 @@ Allocator::Page* Allocator::allocatePages(size_t size)
     }
     _usedMemory = newSize;
 
-    char* mem = static_cast<char*>(malloc(realSize));
+    char* mem = allocateSystemMemory(realSize);
     if (!mem) {
       env.beginOutput();
       reportSpiderStatus('m');
@@ -691,6 +709,110 @@ Allocator::Page* Allocator::allocatePages(size_t size)
 #endif // USE_SYSTEM_ALLOCATION
 } // Allocator::allocatePages
 
+/**
+ * Obtain memory for a new (multi)page from the system. Pages are never given back
+ * before the cleanup, they are reused through the free lists of pages instead.
+ */
+char* Allocator::allocateSystemMemory(size_t size)
+{
+  if (_hugePages) {
+    return allocateFromHugeRegion(size);
+  }
+  return static_cast<char*>(malloc(size));
+}
+
+/**
+ * Carve @b size bytes from a 2 MiB aligned region that is advised to the kernel as a
+ * candidate for transparent huge pages, so that the term sharing structures and the
+ * indices need fewer TLB entries. A new region is mapped when the current one is
+ * too small; the rest of the old one, less than a page in the common case, is lost.
+ *
+ * The memory is not bound to a NUMA node explicitly: it is first touched by the
+ * process that uses it, so the kernel's first-touch policy already places it
+ * on the node that portfolio worker runs on.
+ */
+char* Allocator::allocateFromHugeRegion(size_t size)
+{
+  CALLC("Allocator::allocateFromHugeRegion",MAKE_CALLS);
+
+  if (size > _hugeRegionFreeBytes) {
+    size_t regionSize = ((size + sizeof(HugeRegion) + HUGE_REGION_SIZE - 1) / HUGE_REGION_SIZE) * HUGE_REGION_SIZE;
+    // map one huge page more than needed, so that the region can start on a huge page boundary
+    size_t mapSize = regionSize + HUGE_REGION_SIZE;
+    char* map = static_cast<char*>(mmap(0, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (map == MAP_FAILED) {
+      return 0;
+    }
+    size_t misalignment = reinterpret_cast<size_t>(map) % HUGE_REGION_SIZE;
+    char* start = misalignment ? map + (HUGE_REGION_SIZE - misalignment) : map;
+    char* end = start + regionSize;
+    if (start > map) {
+      munmap(map, start - map);
+    }
+    if (map + mapSize > end) {
+      munmap(end, map + mapSize - end);
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(start, regionSize, MADV_HUGEPAGE);
+#endif
+
+    HugeRegion* region = reinterpret_cast<HugeRegion*>(start);
+    region->next = _hugeRegions;
+    region->size = regionSize;
+    _hugeRegions = region;
+    _hugeRegionCount++;
+    _hugeRegionBytes += regionSize;
+    _hugeRegionFree = start + sizeof(HugeRegion);
+    _hugeRegionFreeBytes = regionSize - sizeof(HugeRegion);
+  }
+
+  char* res = _hugeRegionFree;
+  _hugeRegionFree += size;
+  _hugeRegionFreeBytes -= size;
+  return res;
+}
+
+/** True if @b mem was carved from a huge page region and so must not be freed */
+bool Allocator::inHugeRegion(const void* mem)
+{
+  const char* p = static_cast<const char*>(mem);
+  for (HugeRegion* r = _hugeRegions; r; r = r->next) {
+    const char* start = reinterpret_cast<const char*>(r);
+    if (start <= p && p < start + r->size) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Report how much memory was mapped for huge pages and how much of it the kernel
+ * actually backs by them (transparent huge pages may be disabled or fragmented).
+ */
+void Allocator::printHugePageStatistics(std::ostream& out)
+{
+  CALLC("Allocator::printHugePageStatistics",MAKE_CALLS);
+
+  Shell::addCommentSignForSZS(out);
+  out << "Huge page regions: " << _hugeRegionCount << " (" << _hugeRegionBytes / 1024 << " KB)" << endl;
+
+  BYPASSING_ALLOCATOR;
+  FILE* smaps = fopen("/proc/self/smaps_rollup", "r");
+  if (!smaps) {
+    return;
+  }
+  char line[256];
+  while (fgets(line, sizeof(line), smaps)) {
+    unsigned long kb;
+    if (sscanf(line, "AnonHugePages: %lu kB", &kb) == 1) {
+      Shell::addCommentSignForSZS(out);
+      out << "Memory backed by huge pages: " << kb << " KB" << endl;
+      break;
+    }
+  }
+  fclose(smaps);
+}
+
 /**
  * Deallocate a (multi)page, that is, add it to the free list of
  * pages.
@@ -20,6 +20,7 @@
 #define __Allocator__
 
 #include <cstddef>
+#include <iosfwd>
 
 #include "Debug/Assertion.hpp"
 #include "Debug/Tracer.hpp"
@@ -43,6 +44,8 @@
 /** Any memory piece of this or larger size will be allocated as a page
  *  or contiguous sequence of pages */
 #define REQUIRES_PAGE (VPAGE_SIZE/2)
+/** Size of the regions pages are carved from with --huge_pages (one x86-64 huge page) */
+#define HUGE_REGION_SIZE (2u << 20)
 /** Maximal allowed number of allocators */
 #define MAX_ALLOCATORS 256
 
@@ -103,6 +106,13 @@ public:
     _memoryLimit = size;
     _tolerated = size + (size/10);
   }
+  /** Take new pages from 2 MiB aligned regions backed by transparent huge pages
+   *  rather than from malloc */
+  static void setHugePages(bool enabled)
+  { _hugePages = enabled; }
+  static bool hugePages()
+  { return _hugePages; }
+  static void printHugePageStatistics(std::ostream& out);
   /** The current allocator
    * - through which allocations by the here defined macros are channelled */
   static Allocator* current;
@@ -295,6 +305,24 @@ private:
   Page* allocatePages(size_t size);
   void deallocatePages(Page* page);
 
+  /** Header of a region obtained with mmap for --huge_pages, pages are carved from the rest */
+  struct HugeRegion {
+    HugeRegion* next;
+    size_t size;
+  };
+  static char* allocateSystemMemory(size_t size);
+  static char* allocateFromHugeRegion(size_t size);
+  static bool inHugeRegion(const void* mem);
+
+  static bool _hugePages;
+  /** All the mapped regions, newest first */
+  static HugeRegion* _hugeRegions;
+  /** The part of the newest region not yet given out */
+  static char* _hugeRegionFree;
+  static size_t _hugeRegionFreeBytes;
+  static size_t _hugeRegionCount;
+  static size_t _hugeRegionBytes;
+
   /** The global memory limit */
   static size_t _memoryLimit;
   /** 10% over the memory limit. When reached, memory de-fragmentation
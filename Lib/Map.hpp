@@ -527,6 +527,14 @@ public:
     _afterLast   = nullptr;
     _maxEntries  = 0;
   }
+
+  /** Remove all entries, unlike clear() leaving a map that can be used again */
+  void reset()
+  {
+    CALL("Map::reset");
+    clear();
+    expand();
+  }
   
   /**
    * Delete all entries.
@@ -257,6 +257,38 @@ private:
   T _el;
 };
 
+/**
+ * Iterator over at most @b N elements that are stored inside the iterator itself.
+ *
+ * It is meant for functions that return one of a few small alternatives (e.g. one
+ * or both sides of an equality). Such alternatives have different types, so they
+ * would otherwise be put behind a VirtualIterator, i.e. allocated on the heap and
+ * called virtually for every element. With this iterator the whole pipeline
+ * of a generating inference can stay statically typed and on the stack.
+ */
+template<typename T, unsigned N>
+class InlineArrayIterator
+{
+public:
+  DECL_ELEMENT_TYPE(T);
+  InlineArrayIterator() : _size(0), _next(0) {}
+  InlineArrayIterator(std::initializer_list<T> elems) : _size(0), _next(0)
+  {
+    for (auto& e : elems) {
+      push(e);
+    }
+  }
+  void push(T el) { ASS_L(_size, N); _elems[_size++] = el; }
+  inline bool hasNext() { return _next < _size; }
+  inline T next() { ASS(hasNext()); return _elems[_next++]; }
+  inline bool knowsSize() const { return true; }
+  inline size_t size() const { return _size; }
+private:
+  T _elems[N];
+  unsigned _size;
+  unsigned _next;
+};
+
 /**
  * Return iterator returning @b el as a single element
  *
@@ -20,6 +20,10 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
 
 #include "Lib/Environment.hpp"
 #include "Lib/List.hpp"
@@ -98,6 +102,33 @@ pid_t Multiprocessing::fork()
   return res;
 }
 
+#ifdef __linux__
+/**
+ * Like fork(), but the new process becomes a sibling of the calling one:
+ * it is a child of the caller's parent, which is also the process that
+ * gets notified when it terminates.
+ */
+pid_t Multiprocessing::forkSibling()
+{
+  CALL("Multiprocessing::forkSibling");
+  ASS(!env.haveOutput());
+
+  executeFuncList(_preFork);
+  errno=0;
+  pid_t res=syscall(SYS_clone, CLONE_PARENT | SIGCHLD, 0, 0, 0, 0);
+  if(res==-1) {
+    SYSTEM_FAIL("Call to clone() function failed.", errno);
+  }
+  if(res==0) {
+    executeFuncList(_postForkChild);
+  }
+  else {
+    executeFuncList(_postForkParent);
+  }
+  return res;
+}
+#endif
+
 /**
  * Wait for a first child process to terminate, return its pid and assign
  * its exit status into @b resValue. If the child was terminated by a signal,
@@ -27,6 +27,9 @@ public:
 
   pid_t waitForChildTermination(int& resValue);
   pid_t fork();
+#ifdef __linux__
+  pid_t forkSibling();
+#endif
   void registerForkHandlers(VoidFunc before, VoidFunc afterParent, VoidFunc afterChild);
 
   void kill(pid_t child, int signal);
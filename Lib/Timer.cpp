@@ -53,6 +53,21 @@ long long last_instruction_count_read = -1;
 long Timer::s_ticksPerSec;
 int Timer::s_initGuarantedMiliseconds;
 
+bool Timer::s_hardwareCounting = false;
+
+#ifdef __linux__
+// counters for --hardware_counters, opened as one group so that a single read() gets all of them
+// (in the order cycles, instructions, cache misses, branch misses, dTLB read misses; the first one is the group leader)
+int hw_fds[5] = {-1, -1, -1, -1, -1};
+// position of each counter in the result of the group read, -1 if the hardware does not support it
+int hw_slot[5] = {-1, -1, -1, -1, -1};
+unsigned hw_group_size = 0;
+const char* hw_error = nullptr;
+#endif
+Timer::HardwareCounters hw_totals[Timer::HW_PHASE_CNT];
+Timer::HardwareCounters hw_last;
+Timer::HardwarePhase hw_current = Timer::HW_OTHER;
+
 unsigned Timer::elapsedMegaInstructions() {
 #ifdef __linux__
   return (last_instruction_count_read >= 0) ? last_instruction_count_read/MEGA : 0;
@@ -286,6 +301,155 @@ void Timer::resetInstructionMeasuring()
 #endif
 }
 
+/**
+ * (Re)open the hardware counters for the current process and zero the totals of all phases.
+ * Called at the start of the run and in every portfolio slice, as counters are per process.
+ */
+void Timer::resetHardwareCounters()
+{
+  CALL("Timer::resetHardwareCounters");
+
+  s_hardwareCounting = false;
+  hw_current = HW_OTHER;
+  for (unsigned p = 0; p < HW_PHASE_CNT; p++) {
+    hw_totals[p] = HardwareCounters{0, 0, 0, 0, 0};
+  }
+
+#ifdef __linux__
+  for (unsigned i = 0; i < 5; i++) {
+    if (hw_fds[i] >= 0) {
+      close(hw_fds[i]);
+    }
+    hw_fds[i] = -1;
+    hw_slot[i] = -1;
+  }
+  hw_group_size = 0;
+
+  if (!env.options->hardwareCounters()) {
+    return;
+  }
+
+  static const unsigned types[5] = {
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE };
+  static const unsigned long long configs[5] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) };
+  for (unsigned i = 0; i < 5; i++) {
+    struct perf_event_attr pe;
+    memset(&pe, 0, sizeof(struct perf_event_attr));
+    pe.type = types[i];
+    pe.size = sizeof(struct perf_event_attr);
+    pe.config = configs[i];
+    pe.disabled = (i == 0);
+    pe.exclude_kernel = 1;
+    pe.exclude_hv = 1;
+    pe.read_format = PERF_FORMAT_GROUP;
+
+    hw_fds[i] = perf_event_open(&pe, 0, -1, hw_fds[0], 0);
+    if (hw_fds[i] == -1) {
+      if (i == 0) {
+        hw_error = std::strerror(errno);
+        return;
+      }
+      // e.g. virtual machines often do not expose the cache counters; we go on without them
+      continue;
+    }
+    hw_slot[i] = hw_group_size++;
+  }
+  ioctl(hw_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(hw_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  hw_last = HardwareCounters{0, 0, 0, 0, 0};
+  s_hardwareCounting = true;
+#endif
+}
+
+#ifdef __linux__
+static bool readHardwareCounters(Timer::HardwareCounters& res)
+{
+  // the number of counters followed by their values
+  unsigned long long buf[6];
+  ssize_t expected = sizeof(unsigned long long) * (1 + hw_group_size);
+  if (read(hw_fds[0], buf, sizeof(buf)) < expected) {
+    return false;
+  }
+  auto value = [&](unsigned i) { return hw_slot[i] < 0 ? 0 : buf[1 + hw_slot[i]]; };
+  res = Timer::HardwareCounters{value(0), value(1), value(2), value(3), value(4)};
+  return true;
+}
+#endif
+
+/**
+ * Add the events counted since the last switch to the current phase and make @b phase current.
+ */
+Timer::HardwarePhase Timer::switchHardwarePhase(HardwarePhase phase)
+{
+#ifdef __linux__
+  HardwareCounters now;
+  if (readHardwareCounters(now)) {
+    HardwareCounters& total = hw_totals[hw_current];
+    total.cycles += now.cycles - hw_last.cycles;
+    total.instructions += now.instructions - hw_last.instructions;
+    total.cacheMisses += now.cacheMisses - hw_last.cacheMisses;
+    total.branchMisses += now.branchMisses - hw_last.branchMisses;
+    total.dtlbMisses += now.dtlbMisses - hw_last.dtlbMisses;
+    hw_last = now;
+  }
+#endif
+  HardwarePhase previous = hw_current;
+  hw_current = phase;
+  return previous;
+}
+
+/**
+ * Print the hardware counters of each phase. This may be called from limitReached, so it must not allocate.
+ */
+void Timer::printHardwareCounters(ostream& out)
+{
+  using namespace Shell;
+
+#ifdef __linux__
+  if (!s_hardwareCounting) {
+    if (hw_error) {
+      addCommentSignForSZS(out);
+      out << "Hardware counters not available: " << hw_error << endl;
+    }
+    return;
+  }
+  // account for the events since the last switch
+  switchHardwarePhase(hw_current);
+
+  static const char* names[HW_PHASE_CNT] = {
+    "other", "unprocessed loop", "activation", "backward simplification", "AVATAR" };
+  auto printCounter = [&](unsigned i, unsigned long long value) {
+    out << ", ";
+    if (hw_slot[i] < 0) {
+      out << "n/a";
+    } else {
+      out << value;
+    }
+  };
+
+  addCommentSignForSZS(out);
+  out << "Hardware counters (cycles, instructions, instructions per cycle, cache misses, branch misses, dTLB misses):" << endl;
+  for (unsigned p = 0; p < HW_PHASE_CNT; p++) {
+    const HardwareCounters& c = hw_totals[p];
+    if (!c.cycles) {
+      continue;
+    }
+    unsigned long long ipc100 = c.instructions * 100 / c.cycles;
+    addCommentSignForSZS(out);
+    out << "  " << names[p] << ": " << c.cycles;
+    printCounter(1, c.instructions);
+    out << ", " << ipc100 / 100 << '.' << (ipc100 % 100 < 10 ? "0" : "") << ipc100 % 100;
+    printCounter(2, c.cacheMisses);
+    printCounter(3, c.branchMisses);
+    printCounter(4, c.dtlbMisses);
+    out << endl;
+  }
+#endif
+}
+
 bool Timer::instructionLimitingInPlace()
 {
 #ifdef __linux__
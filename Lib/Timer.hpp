@@ -96,6 +96,35 @@ public:
   static unsigned elapsedMegaInstructions();
   static void resetInstructionMeasuring();
 
+  /**
+   * Parts of the run the hardware counters are split into (--hardware_counters).
+   * Each counted event belongs to exactly one phase, the innermost one entered.
+   */
+  enum HardwarePhase : unsigned {
+    HW_OTHER,
+    HW_UNPROCESSED_LOOP,
+    HW_ACTIVATION,
+    HW_BACKWARD_SIMPLIFICATION,
+    HW_AVATAR,
+    HW_PHASE_CNT
+  };
+
+  struct HardwareCounters {
+    unsigned long long cycles;
+    unsigned long long instructions;
+    unsigned long long cacheMisses;
+    unsigned long long branchMisses;
+    unsigned long long dtlbMisses;
+  };
+
+  static void resetHardwareCounters();
+  /** Make @b phase the current one and return the one that was current before */
+  static HardwarePhase enterHardwarePhase(HardwarePhase phase)
+  { return s_hardwareCounting ? switchHardwarePhase(phase) : phase; }
+  static void leaveHardwarePhase(HardwarePhase previous)
+  { if (s_hardwareCounting) { switchHardwarePhase(previous); } }
+  static void printHardwareCounters(std::ostream& out);
+
   static std::atomic<bool> s_limitEnforcement;
 private:
   /** true if the timer is running */
@@ -112,6 +141,9 @@ private:
 
   static int guaranteedMilliseconds();
 
+  static HardwarePhase switchHardwarePhase(HardwarePhase phase);
+  static bool s_hardwareCounting;
+
   static long s_ticksPerSec;
   static int s_initGuarantedMiliseconds;
 
@@ -138,6 +170,16 @@ struct TimeoutProtector {
   ~TimeoutProtector();
 }; // struct TimeoutProtector
 
+/**
+ * Attributes the hardware events of the enclosing block to the given phase.
+ */
+struct HardwarePhaseScope {
+  HardwarePhaseScope(Timer::HardwarePhase phase) : _previous(Timer::enterHardwarePhase(phase)) {}
+  ~HardwarePhaseScope() { Timer::leaveHardwarePhase(_previous); }
+private:
+  Timer::HardwarePhase _previous;
+}; // struct HardwarePhaseScope
+
 } // namespace Lib
 
 #endif /* __Timer__ */
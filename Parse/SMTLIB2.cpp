@@ -58,7 +58,8 @@ SMTLIB2::SMTLIB2(const Options& opts)
 : _logicSet(false),
   _logic(SMT_UNDEFINED),
   _numeralsAreReal(false),
-  _formulas(nullptr)
+  _formulas(nullptr),
+  _uncountedExpr(nullptr)
 {
   CALL("SMTLIB2::SMTLIB2");
 }
@@ -67,10 +68,11 @@ void SMTLIB2::parse(istream& str)
 {
   CALL("SMTLIB2::parse(istream&)");
 
+  // the commands are read (and freed) one by one, so that
+  // the whole benchmark never needs to be in memory as a lisp tree
   LispLexer lex(str);
   LispParser lpar(lex);
-  LExpr* expr = lpar.parse();
-  parse(expr);
+  readBenchmark([&lpar]() { return lpar.parseNext(); }, true);
 }
 
 void SMTLIB2::parse(LExpr* bench)
@@ -78,20 +80,29 @@ void SMTLIB2::parse(LExpr* bench)
   CALL("SMTLIB2::parse(LExpr*)");
 
   ASS(bench->isList());
-  readBenchmark(bench->list);
+  LExprList::Iterator bIt(bench->list);
+  readBenchmark([&bIt]() { return bIt.hasNext() ? bIt.next() : nullptr; }, false);
 }
 
-void SMTLIB2::readBenchmark(LExprList* bench)
+void SMTLIB2::releaseCommand(LExpr* command, bool freeCommands)
+{
+  CALL("SMTLIB2::releaseCommand");
+
+  // sort definitions keep pointing into their command, see SortDefinition
+  if (freeCommands && !LispListReader(command).lookAheadAtom("define-sort")) {
+    command->destroy();
+  }
+}
+
+template<class NextCommand>
+void SMTLIB2::readBenchmark(NextCommand nextCommand, bool freeCommands)
 {
   CALL("SMTLIB2::readBenchmark");
-  LispListReader bRdr(bench);
 
   bool afterCheckSat = false;
 
   // iteration over benchmark top level entries
-  while(bRdr.hasNext()) {
-    LExpr* lexp = bRdr.next();
-
+  for (LExpr* lexp; (lexp = nextCommand()); releaseCommand(lexp, freeCommands)) {
     LOG2("readBenchmark ",lexp->toString(true));
 
     LispListReader ibRdr(lexp);
@@ -311,7 +322,9 @@ void SMTLIB2::readBenchmark(LExprList* bench)
     }
 
     if (ibRdr.tryAcceptAtom("exit")) {
-      bRdr.acceptEOL();
+      if (LExpr* rest = nextCommand()) {
+        USER_ERROR("<eol> expected: "+rest->toString());
+      }
       break;
     }
 
@@ -342,12 +355,15 @@ void SMTLIB2::readBenchmark(LExprList* bench)
   // however, we want to learn about an unsat core printing request
   // (or other things we might support in the future)
   if (afterCheckSat) {
-    while(bRdr.hasNext()) {
-      LispListReader ibRdr(bRdr.next());
+    for (LExpr* lexp; (lexp = nextCommand()); releaseCommand(lexp, freeCommands)) {
+      LispListReader ibRdr(lexp);
       
       if (ibRdr.tryAcceptAtom("exit")) {
         ibRdr.acceptEOL(); // no arguments of exit
-        bRdr.acceptEOL();  // exit should be the last thing in the file
+        // exit should be the last thing in the file
+        if (LExpr* rest = nextCommand()) {
+          USER_ERROR("<eol> expected: "+rest->toString());
+        }
         break;
       }
       
@@ -1443,6 +1459,33 @@ void SMTLIB2::parseLetBegin(LExpr* exp)
   }
 }
 
+/** Let-bound terms up to this weight and used at most once are substituted for their names */
+static const unsigned LET_INLINE_WEIGHT_LIMIT = 4;
+
+void SMTLIB2::countAtomOccurrences()
+{
+  CALL("SMTLIB2::countAtomOccurrences");
+
+  if (!_uncountedExpr) {
+    return;
+  }
+
+  Stack<LExpr*> todo;
+  todo.push(_uncountedExpr);
+  _uncountedExpr = nullptr;
+
+  while (todo.isNonEmpty()) {
+    LExpr* exp = todo.pop();
+    if (exp->isAtom()) {
+      unsigned* cnt;
+      _atomOccurrences.getValuePtr(exp->str,cnt,0);
+      (*cnt)++;
+    } else {
+      todo.loadFromIterator(LExprList::Iterator(exp->list));
+    }
+  }
+}
+
 void SMTLIB2::parseLetPrepareLookup(LExpr* exp)
 {
   CALL("SMTLIB2::parseLetPrepareLookup");
@@ -1461,15 +1504,27 @@ void SMTLIB2::parseLetPrepareLookup(LExpr* exp)
 
   TermLookup* lookup = new TermLookup();
 
+  countAtomOccurrences();
+
   while (bindRdr.hasNext()) {
     LExprList* pair = bindRdr.readList();
     LispListReader pRdr(pair);
 
     const vstring& cName = pRdr.readAtom();
-    TermList sort = (--boundExprs)->sort; // the should be big enough (
+    ParseResult& boundExpr = *(--boundExprs); // the should be big enough (
+    TermList sort = boundExpr.sort;
 
     TermList trm;
-    if (sort == AtomicSort::boolSort()) {
+    if (sort != AtomicSort::boolSort() && boundExpr.isSharedTerm() &&
+        (boundExpr.trm.isVar() ||
+         (boundExpr.trm.term()->weight() <= LET_INLINE_WEIGHT_LIMIT &&
+          _atomOccurrences.get(cName) <= 2))) { // the binding itself and a single use
+      // a variable, or a small term used once, can stand for the name itself, saving a fresh symbol
+      // and a definition (variables are numbered apart per formula, so nothing can get captured);
+      // other terms are named, since later passes see terms as trees and inlining
+      // them into nested lets would make the problem grow exponentially
+      trm = boundExpr.trm;
+    } else if (sort == AtomicSort::boolSort()) {
       unsigned symb = env.signature->addFreshPredicate(0,"sLP");
       OperatorType* type = OperatorType::getPredicateType(0, nullptr);
       env.signature->getPredicate(symb)->setType(type);
@@ -1530,6 +1585,11 @@ void SMTLIB2::parseLetEnd(LExpr* exp)
     TermList exprTerm = term.first;
     TermList exprSort = term.second;
 
+    if (exprTerm == boundExpr) {
+      // bound directly in parseLetPrepareLookup, there is no symbol to bind
+      continue;
+    }
+
     unsigned symbol = 0;
     if (exprSort == AtomicSort::boolSort()) { // it has to be formula term, with atomic formula
       symbol = exprTerm.term()->getSpecialData()->getFormula()->literal()->functor();
@@ -2548,6 +2608,9 @@ SMTLIB2::ParseResult SMTLIB2::parseTermOrFormula(LExpr* body)
   ASS(_todo.isEmpty());
   ASS(_results.isEmpty());
 
+  _atomOccurrences.reset();
+  _uncountedExpr = body;
+
   _todo.push(make_pair(PO_PARSE,body));
 
   while (_todo.isNonEmpty()) {
@@ -352,6 +352,12 @@ private:
    */
   Scopes _scopes;
 
+  /** How often each atom occurs in the term or formula being parsed (counted on the first let) */
+  DHMap<vstring,unsigned> _atomOccurrences;
+  /** The term or formula being parsed, as long as its atoms have not been counted yet */
+  LExpr* _uncountedExpr;
+  void countAtomOccurrences();
+
   /**
    * Stack of partial results used by parseTermOrFormula below.
    */
@@ -484,9 +490,16 @@ private:
   Set<vstring> _overflow;
 
   /**
-   * Toplevel parsing dispatch for a benchmark.
+   * Toplevel parsing dispatch for a benchmark, whose commands
+   * are supplied one by one by @b nextCommand.
+   */
+  template<class NextCommand>
+  void readBenchmark(NextCommand nextCommand, bool freeCommands);
+
+  /**
+   * Destroy a top-level command once it has been read, if @b freeCommands is set.
    */
-  void readBenchmark(LExprList* bench);
+  void releaseCommand(LExpr* command, bool freeCommands);
 };
 
 }
@@ -34,6 +34,7 @@
 #include "Kernel/BottomUpEvaluation/TermList.hpp"
 #include "Lib/Coproduct.hpp"
 
+#include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 #include "Indexing/TermSharing.hpp"
 #include "Z3Interfacing.hpp"
@@ -123,7 +124,8 @@ Z3Interfacing::Z3Interfacing(SAT2FO& s2f, bool showZ3, bool unsatCoresForAssumpt
   _assumptions(),
   _showZ3(showZ3),
   _unsatCore(unsatCoresForAssumptions),
-  _out()
+  _out(),
+  _cacheLimit(env.options->z3CacheLimit())
 {
   CALL("Z3Interfacing::Z3Interfacing");
   BYPASSING_ALLOCATOR
@@ -260,6 +262,7 @@ SATSolver::Status Z3Interfacing::solve()
 {
   CALL("Z3Interfacing::solve()");
   BYPASSING_ALLOCATOR;
+  trimCaches();
   DEBUG("assumptions: ", _assumptions);
 
   output("(check-sat-assuming (");
@@ -874,15 +877,16 @@ struct ToZ3Expr
     if(trm->numTermArguments()==0) {
       if(symb->integerConstant()){
         IntegerConstantType value = symb->integerValue();
-        return self._context.int_val(value.toInner());
+        // the string versions also take numbers that do not fit into a machine integer
+        return self._context.int_val(value.toString().c_str());
       }
       if(symb->realConstant()) {
         RealConstantType value = symb->realValue();
-        return self._context.real_val(value.numerator().toInner(),value.denominator().toInner());
+        return self._context.real_val(value.toString().c_str());
       }
       if(symb->rationalConstant()) {
         RationalConstantType value = symb->rationalValue();
-        return self._context.real_val(value.numerator().toInner(),value.denominator().toInner());
+        return self._context.real_val(value.toString().c_str());
       }
       if(!isLit && env.signature->isFoolConstantSymbol(true,trm->functor())) {
         return self._context.bool_val(true);
@@ -1142,7 +1146,7 @@ Z3Interfacing::Representation Z3Interfacing::getRepresentation(SATLiteral slit)
     //cout << "getRepresentation of " << lit->toString() << endl;
     // Now translate it into an SMT object
     try{
-      auto repr = getRepresentation(lit);
+      auto repr = getCachedRepresentation(lit);
 
       /* we name all literals in order to make z3 cache their truth values.
        * this gives a massive performance boost in many cases.              */
@@ -1176,6 +1180,54 @@ Z3Interfacing::Representation Z3Interfacing::getRepresentation(SATLiteral slit)
   }
 }
 
+/**
+ * Translate the ground literal @b lit into a Z3 term, reusing the translation
+ * from an earlier call if there is one. Theory instantiation asks about the same
+ * literals over and over, as its fresh constants are recycled between premises.
+ */
+Z3Interfacing::Representation Z3Interfacing::getCachedRepresentation(Literal* lit)
+{
+  CALL("Z3Interfacing::getCachedRepresentation");
+
+  auto cached = _literalRepresentations.getPtr(lit);
+  if (cached) {
+    env.statistics->z3TranslationReuse++;
+    return Representation(cached->expr, cached->defs);
+  }
+  auto repr = getRepresentation(lit);
+  _literalRepresentations.getOrInit(lit, [&]() { return Representation(repr.expr, repr.defs); });
+  return repr;
+}
+
+/**
+ * Keep the caches of translated expressions within the limit given by
+ * the z3_cache_limit option.
+ *
+ * A dropped entry only costs its retranslation, since Z3 identifies
+ * constants by name and sort and so gives back the same expression.
+ * The name caches are kept when the problems are exported though,
+ * as refilling them would repeat declarations in the exported file.
+ */
+void Z3Interfacing::trimCaches()
+{
+  CALL("Z3Interfacing::trimCaches");
+
+  if (!_cacheLimit) {
+    return;
+  }
+  if ((unsigned)_literalRepresentations.size() > _cacheLimit) {
+    _literalRepresentations.reset();
+    env.statistics->z3CacheFlushes++;
+  }
+  if (_out.isNone() &&
+      (unsigned)(_varNames.size() + _termIndexedConstants.size() + _constantNames.size()) > _cacheLimit) {
+    _varNames.reset();
+    _termIndexedConstants.reset();
+    _constantNames.reset();
+    env.statistics->z3CacheFlushes++;
+  }
+}
+
 SATClause* Z3Interfacing::getRefutation()
 {
   CALL("Z3Interfacing::getRefutation");
@@ -1193,6 +1245,7 @@ Z3Interfacing::~Z3Interfacing()
   _sorts.clear();
   _toZ3.clear();
   _fromZ3.clear();
+  _literalRepresentations.clear();
   outputln(); // flush the output file
 }
 
@@ -228,6 +228,7 @@ private:
   {
     Representation(z3::expr expr, Stack<z3::expr> defs) : expr(expr), defs(defs) {}
     Representation(Representation&&) = default;
+    Representation& operator=(Representation&&) = default;
     z3::expr expr;
     Stack<z3::expr> defs;
   };
@@ -235,6 +236,8 @@ private:
   Representation getRepresentation(Term* trm);
   Representation getRepresentation(SATLiteral lit);
   Representation getRepresentation(SATClause* cl);
+  Representation getCachedRepresentation(Literal* lit);
+  void trimCaches();
 
   // arrays are a bit fragile in Z3, so we need to do things differently for them
   bool _hasSeenArrays;
@@ -256,6 +259,11 @@ private:
   Map<TermList, z3::expr> _termIndexedConstants;
   Map<Signature::Symbol*, z3::expr> _constantNames;
 
+  /** translations of the ground literals seen so far, see getCachedRepresentation() */
+  Map<Literal*, Representation> _literalRepresentations;
+  /** the number of cached expressions above which trimCaches() drops them, 0 for no limit */
+  const unsigned _cacheLimit;
+
   bool     isNamedExpr(unsigned var) const;
   z3::expr getNameExpr(unsigned var);
 
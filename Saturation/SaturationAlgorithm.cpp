@@ -32,6 +32,7 @@
 #include "Kernel/FormulaUnit.hpp"
 #include "Kernel/Inference.hpp"
 #include "Kernel/InferenceStore.hpp"
+#include "Kernel/InferenceTrace.hpp"
 #include "Kernel/KBO.hpp"
 #include "Kernel/LiteralSelector.hpp"
 #include "Kernel/MLVariant.hpp"
@@ -129,6 +130,22 @@ using namespace Saturation;
 
 SaturationAlgorithm* SaturationAlgorithm::s_instance = 0;
 
+using RuleCostClock = std::chrono::steady_clock;
+
+/**
+ * Add the time since @b start to the cost of the rule that concluded @b cl,
+ * or to @b unattributed if there is no conclusion. Used with --inference_rule_statistics.
+ */
+static void addInferenceRuleTime(RuleCostClock::time_point start, Clause* cl, unsigned long long& unattributed)
+{
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(RuleCostClock::now() - start).count();
+  if (cl) {
+    env.statistics->inferenceRuleCost(cl->inference().rule()).time += ns;
+  } else {
+    unattributed += ns;
+  }
+}
+
 std::unique_ptr<PassiveClauseContainer> makeLevel0(bool isOutermost, const Options& opt, vstring name)
 {
   return std::make_unique<AWPassiveClauseContainer>(isOutermost, opt, name + "AWQ");
@@ -223,7 +240,8 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
     _consFinder(0), _labelFinder(0), _symEl(0), _answerLiteralManager(0),
     _instantiation(0),
     _generatedClauseCount(0),
-    _activationLimit(0)
+    _activationLimit(0),
+    _nextInputStageActivation(0)
 {
   CALL("SaturationAlgorithm::SaturationAlgorithm");
   ASS_EQ(s_instance, 0);  //there can be only one saturation algorithm at a time
@@ -389,6 +407,7 @@ void SaturationAlgorithm::onAllProcessed()
   }
 
   if (_splitter) {
+    HardwarePhaseScope hwPhase(Timer::HW_AVATAR);
     _splitter->onAllProcessed();
   }
 
@@ -689,6 +708,24 @@ void SaturationAlgorithm::addInputClause(Clause* cl)
   env.statistics->initialClauses++;
 }
 
+/**
+ * Add the staged input clauses of the lowest SInE level left
+ *
+ * The next stage is due once as many clauses have been activated
+ * as have been input so far, or earlier if the passive container runs empty.
+ */
+void SaturationAlgorithm::addNextInputStage()
+{
+  CALL("SaturationAlgorithm::addNextInputStage");
+  ASS(_stagedInput.isNonEmpty());
+
+  unsigned level = _stagedInput.top()->getSineLevel();
+  while (_stagedInput.isNonEmpty() && _stagedInput.top()->getSineLevel() == level) {
+    addInputClause(_stagedInput.pop());
+  }
+  _nextInputStageActivation = env.statistics->activations + env.statistics->initialClauses;
+}
+
 /**
  * Return literal selector that is to be used for set-of-support clauses
  */
@@ -782,9 +819,37 @@ void SaturationAlgorithm::init()
     toAdd = _prb.clauseIterator();
   }
 
-  while (toAdd.hasNext()) {
-    Clause* cl=toAdd.next();
-    addInputClause(cl);
+  if (_opt.stagedInput()) {
+    Stack<Clause*> input;
+    input.loadFromIterator(toAdd);
+
+    // counting sort by the (byte sized) SInE level, with the lowest level on top
+    // and the input order within a level kept for popping; std::stable_sort
+    // would take its buffer from the nothrow global new, bypassing Allocator
+    size_t levelStart[256] = {};
+    for (Clause* cl : input) {
+      levelStart[cl->getSineLevel()]++;
+    }
+    size_t start = 0;
+    for (int level = 255; level >= 0; level--) {
+      size_t cnt = levelStart[level];
+      levelStart[level] = start;
+      start += cnt;
+    }
+    _stagedInput = input; // just to get the size, all the elements are overwritten
+    for (size_t i = input.size(); i-- > 0; ) {
+      Clause* cl = input[i];
+      _stagedInput[levelStart[cl->getSineLevel()]++] = cl;
+    }
+
+    if (_stagedInput.isNonEmpty()) {
+      addNextInputStage();
+    }
+  } else {
+    while (toAdd.hasNext()) {
+      Clause* cl=toAdd.next();
+      addInputClause(cl);
+    }
   }
 
   if (_splitter) {
@@ -937,6 +1002,9 @@ void SaturationAlgorithm::addUnprocessedClause(Clause* cl)
 
   _generatedClauseCount++;
   env.statistics->generatedClauses++;
+  if (_opt.inferenceRuleStatistics()) {
+    env.statistics->inferenceRuleCost(cl->inference().rule()).generated++;
+  }
 
   env.checkTimeSometime<64>();
 
@@ -1027,6 +1095,7 @@ bool SaturationAlgorithm::forwardSimplify(Clause* cl)
     return false;
   }
 
+  bool ruleStats = _opt.inferenceRuleStatistics();
   FwSimplList::Iterator fsit(_fwSimplifiers);
 
   while (fsit.hasNext()) {
@@ -1036,7 +1105,12 @@ bool SaturationAlgorithm::forwardSimplify(Clause* cl)
       Clause* replacement = 0;
       ClauseIterator premises = ClauseIterator::getEmpty();
 
-      if (fse->perform(cl,replacement,premises)) {
+      auto start = ruleStats ? RuleCostClock::now() : RuleCostClock::time_point();
+      bool simplified = fse->perform(cl,replacement,premises);
+      if (ruleStats) {
+        addInferenceRuleTime(start, replacement, env.statistics->unattributedForwardSimplificationTime);
+      }
+      if (simplified) {
         if (replacement) {
           addNewClause(replacement);
         }
@@ -1056,12 +1130,21 @@ bool SaturationAlgorithm::forwardSimplify(Clause* cl)
     SimplificationEngine* se=sit.next();
 
     {
+      auto start = ruleStats ? RuleCostClock::now() : RuleCostClock::time_point();
       ClauseIterator results = se->perform(cl);
+      bool simplified = results.hasNext();
+      if (ruleStats && !simplified) {
+        addInferenceRuleTime(start, 0, env.statistics->unattributedForwardSimplificationTime);
+      }
  
-      if (results.hasNext()) {
+      if (simplified) {
         while(results.hasNext()){
           Clause* simpedCl = results.next();
           ASS(simpedCl != cl);
+          if (ruleStats) {
+            addInferenceRuleTime(start, simpedCl, env.statistics->unattributedForwardSimplificationTime);
+            start = RuleCostClock::now();
+          }
           repStack.push(simpedCl);
           addNewClause(simpedCl);
         }
@@ -1075,6 +1158,7 @@ bool SaturationAlgorithm::forwardSimplify(Clause* cl)
   cl->incRefCnt();
 
   if ( _splitter && !_opt.splitAtActivation() ) {
+    HardwarePhaseScope hwPhase(Timer::HW_AVATAR);
     if (_splitter->doSplitting(cl)) {
       return false;
     }
@@ -1090,12 +1174,15 @@ void SaturationAlgorithm::backwardSimplify(Clause* cl)
 {
   CALL("SaturationAlgorithm::backwardSimplify");
   TIME_TRACE("backward simplification");
+  HardwarePhaseScope hwPhase(Timer::HW_BACKWARD_SIMPLIFICATION);
 
 
+  bool ruleStats = _opt.inferenceRuleStatistics();
   BwSimplList::Iterator bsit(_bwSimplifiers);
   while (bsit.hasNext()) {
     BackwardSimplificationEngine* bse=bsit.next();
 
+    auto start = ruleStats ? RuleCostClock::now() : RuleCostClock::time_point();
     BwSimplificationRecordIterator simplifications;
     bse->perform(cl,simplifications);
     while (simplifications.hasNext()) {
@@ -1104,6 +1191,9 @@ void SaturationAlgorithm::backwardSimplify(Clause* cl)
       ASS_NEQ(redundant, cl);
 
       Clause* replacement=srec.replacement;
+      if (ruleStats) {
+        addInferenceRuleTime(start, replacement, env.statistics->unattributedBackwardSimplificationTime);
+      }
 
       if (replacement) {
 	addNewClause(replacement);
@@ -1119,6 +1209,12 @@ void SaturationAlgorithm::backwardSimplify(Clause* cl)
       removeActiveOrPassiveClause(redundant);
 
       redundant->decRefCnt();
+      if (ruleStats) {
+        start = RuleCostClock::now();
+      }
+    }
+    if (ruleStats) {
+      addInferenceRuleTime(start, 0, env.statistics->unattributedBackwardSimplificationTime);
     }
   }
 }
@@ -1170,11 +1266,18 @@ void SaturationAlgorithm::addToPassive(Clause* cl)
 
   cl->setStore(Clause::PASSIVE);
   env.statistics->passiveClauses++;
+  if (_opt.inferenceRuleStatistics()) {
+    env.statistics->inferenceRuleCost(cl->inference().rule()).retained++;
+  }
 
   {
     TIME_TRACE(TimeTrace::PASSIVE_CONTAINER_MAINTENANCE);
     _passive->add(cl);
   }
+
+  if (InferenceTrace::instance()->enabled()) {
+    InferenceTrace::instance()->recordAndDetach(cl);
+  }
 }
 
 void SaturationAlgorithm::removeSelected(Clause* cl)
@@ -1200,6 +1303,7 @@ void SaturationAlgorithm::activate(Clause* cl)
 {
   CALL("SaturationAlgorithm::activate");
       TIME_TRACE("activation")
+  HardwarePhaseScope hwPhase(Timer::HW_ACTIVATION);
 
   {
   TIME_TRACE("redundancy check")
@@ -1211,6 +1315,7 @@ void SaturationAlgorithm::activate(Clause* cl)
   {
   TIME_TRACE("splitting")
   if (_splitter && _opt.splitAtActivation()) {
+    HardwarePhaseScope hwPhase(Timer::HW_AVATAR);
     if (_splitter->doSplitting(cl)) {
       return removeSelected(cl);
     }
@@ -1236,12 +1341,21 @@ void SaturationAlgorithm::activate(Clause* cl)
   cl->setStore(Clause::ACTIVE);
   env.statistics->activeClauses++;
   _active->add(cl);
+  bool ruleStats = _opt.inferenceRuleStatistics();
+  if (ruleStats) {
+    env.statistics->inferenceRuleCost(cl->inference().rule()).activated++;
+  }
     
+  // the time between two generated clauses is the cost of the latter
+  auto start = ruleStats ? RuleCostClock::now() : RuleCostClock::time_point();
   auto generated = TIME_TRACE_EXPR(TimeTrace::CLAUSE_GENERATION, _generator->generateSimplify(cl));
   auto toAdd = timeTraceIter(TimeTrace::CLAUSE_GENERATION, generated.clauses);
 
   while (toAdd.hasNext()) {
     Clause* genCl=toAdd.next();
+    if (ruleStats) {
+      addInferenceRuleTime(start, genCl, env.statistics->unattributedGeneratingInferenceTime);
+    }
     addNewClause(genCl);
 
     Inference::Iterator iit=genCl->inference().iterator();
@@ -1255,6 +1369,13 @@ void SaturationAlgorithm::activate(Clause* cl)
         onParenthood(genCl, premCl);
       }
     }
+    if (ruleStats) {
+      start = RuleCostClock::now();
+    }
+  }
+  if (ruleStats) {
+    // the search after the last conclusion
+    addInferenceRuleTime(start, 0, env.statistics->unattributedGeneratingInferenceTime);
   }
 
   _clauseActivationInProgress=false;
@@ -1287,6 +1408,7 @@ void SaturationAlgorithm::activate(Clause* cl)
 void SaturationAlgorithm::doUnprocessedLoop()
 {
   CALL("SaturationAlgorithm::doUnprocessedLoop");
+  HardwarePhaseScope hwPhase(Timer::HW_UNPROCESSED_LOOP);
 
 start:
 
@@ -1368,8 +1490,18 @@ void SaturationAlgorithm::doOneAlgorithmStep()
 {
   CALL("SaturationAlgorithm::doOneAlgorithmStep");
 
+  if (_stagedInput.isNonEmpty() && env.statistics->activations >= _nextInputStageActivation) {
+    addNextInputStage();
+  }
+
   doUnprocessedLoop();
 
+  // the problem is not saturated before all of its input is in
+  while (_passive->isEmpty() && _stagedInput.isNonEmpty()) {
+    addNextInputStage();
+    doUnprocessedLoop();
+  }
+
   if (_passive->isEmpty()) {
     MainLoopResult::TerminationReason termReason =
 	isComplete() ? Statistics::SATISFIABLE : Statistics::REFUTATION_NOT_FOUND;
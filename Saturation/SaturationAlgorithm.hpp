@@ -163,6 +163,7 @@ private:
   void passiveRemovedHandler(Clause* cl);
   void activeRemovedHandler(Clause* cl);
   void addInputClause(Clause* cl);
+  void addNextInputStage();
 
   LiteralSelector& getSosLiteralSelector();
 
@@ -238,6 +239,14 @@ protected:
   unsigned _generatedClauseCount;
 
   unsigned _activationLimit;
+
+  /**
+   * Input clauses left for later stages by the staged_input option,
+   * those of the lowest SInE level on top
+   */
+  Stack<Clause*> _stagedInput;
+  /** Number of activations after which the next stage of the input is added */
+  unsigned _nextInputStageActivation;
 private:
   static ImmediateSimplificationEngine* createISE(Problem& prb, const Options& opt, Ordering& ordering);
 };
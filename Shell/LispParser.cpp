@@ -155,10 +155,72 @@ void LispParser::parse(List** expr0)
   parsing_level_done:
     ASS(stack.isNonEmpty());
     expr = stack.pop();
+    if (stack.isEmpty()) {
+      // the list we were asked to fill has been closed (see parseNext())
+      return;
+    }
   }
 
 } // parse()
 
+/**
+ * Read the next top-level expression of the input and return it,
+ * or return 0 if the input has been read to the end.
+ *
+ * Unlike parse(), this allows processing the input one top-level
+ * expression at a time, so that the caller can destroy each expression
+ * once it is done with it instead of holding the whole input in memory.
+ */
+LispParser::Expression* LispParser::parseNext()
+{
+  CALL("LispParser::parseNext");
+  ASS_EQ(_balance,0);
+
+  Token t;
+  _lexer.readToken(t);
+  switch (t.tag) {
+  case TT_EOF:
+    return 0;
+  case TT_RPAR:
+    throw Exception("unmatched right parenthesis",t);
+  case TT_LPAR:
+    {
+      _balance++;
+      Expression* result = new Expression(LIST);
+      parse(&result->list);
+      ASS_EQ(_balance,0);
+      return result;
+    }
+  case TT_NAME:
+  case TT_INTEGER:
+  case TT_REAL:
+    return new Expression(ATOM,t.text);
+  default:
+    ASSERTION_VIOLATION;
+  }
+} // parseNext()
+
+/**
+ * Delete this expression together with all its subexpressions.
+ */
+void LispParser::Expression::destroy()
+{
+  CALL("LispParser::Expression::destroy");
+
+  // deeply nested inputs are common, so don't recurse
+  static Stack<Expression*> todo;
+  ASS(todo.isEmpty());
+  todo.push(this);
+  while (todo.isNonEmpty()) {
+    Expression* e = todo.pop();
+    for (List* l = e->list; l; l = l->tail()) {
+      todo.push(l->head());
+    }
+    List::destroy(e->list);
+    delete e;
+  }
+} // LispParser::Expression::destroy
+
 /**
  * Return a LISP string corresponding to this expression
  * @since 26/08/2009 Redmond
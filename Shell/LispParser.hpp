@@ -72,6 +72,7 @@ public:
 	list(0)
     {}
     vstring toString(bool outerParentheses=true) const;
+    void destroy();
 
     bool isList() const { return tag==LIST; }
     bool isAtom() const { return tag==ATOM; }
@@ -86,6 +87,7 @@ public:
 
   explicit LispParser(LispLexer& lexer);
   Expression* parse();
+  Expression* parseNext();
   void parse(List**);
 
   /**
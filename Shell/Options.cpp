@@ -88,6 +88,11 @@ void Options::init()
     _memoryLimit.description="Memory limit in MB";
     _lookup.insert(&_memoryLimit);
 
+    _hugePages = BoolOptionValue("huge_pages","",false);
+    _hugePages.description="Take the memory for the allocator from 2 MiB aligned regions advised for transparent huge pages instead of from malloc. This reduces TLB misses on large problems. The statistics then report how much memory the kernel actually backs by huge pages.";
+    _lookup.insert(&_hugePages);
+    _hugePages.tag(OptionTag::DEVELOPMENT);
+
 #ifdef __linux__
   _instructionLimit = UnsignedOptionValue("instruction_limit","i",0);
   _instructionLimit.description="Limit the number (in millions) of executed instructions (excluding the kernel ones).";
@@ -186,6 +191,11 @@ void Options::init()
     _lookup.insert(&_randomizSeedForPortfolioWorkers);
     _randomizSeedForPortfolioWorkers.onlyUsefulWith(UsingPortfolioTechnology());
 
+    _preprocessingZygotes = BoolOptionValue("preprocessing_zygotes","",false);
+    _preprocessingZygotes.description = "In portfolio mode, preprocess the problem only once for all the slices that agree on the options relevant to preprocessing, in a zygote process from which the workers of these slices are then forked. This saves the repeated preprocessing of large inputs. Only available on Linux.";
+    _lookup.insert(&_preprocessingZygotes);
+    _preprocessingZygotes.onlyUsefulWith(UsingPortfolioTechnology());
+
     _ltbLearning = ChoiceOptionValue<LTBLearning>("ltb_learning","ltbl",LTBLearning::OFF,{"on","off","biased"});
     _ltbLearning.description = "Perform learning in LTB mode";
     _lookup.insert(&_ltbLearning);
@@ -196,6 +206,16 @@ void Options::init()
     _lookup.insert(&_ltbDirectory);
     _ltbDirectory.setExperimental();
 
+    _ltbConcurrentProblems = UnsignedOptionValue("ltb_concurrent_problems","",1);
+    _ltbConcurrentProblems.description = "Number of batch problems attempted concurrently in LTB mode. The available cores are split evenly between them. Set to 0 to run one problem per core.";
+    _lookup.insert(&_ltbConcurrentProblems);
+    _ltbConcurrentProblems.setExperimental();
+
+    _ltbSharedSine = BoolOptionValue("ltb_shared_sine","",false);
+    _ltbSharedSine.description = "In LTB mode, build the SInE D-relation of the included axioms once before the problems are attempted and let every slice select from it, instead of running SInE over all axioms in each slice. Only used by slices with sine_tolerance at most 5.";
+    _lookup.insert(&_ltbSharedSine);
+    _ltbSharedSine.setExperimental();
+
     _decode = DecodeOptionValue("decode","",this);
     _decode.description="Decodes an encoded strategy. Can be used to replay a strategy. To make Vampire output an encoded version of the strategy use the encode option.";
     _lookup.insert(&_decode);
@@ -306,6 +326,14 @@ void Options::init()
     _lookup.insert(&_printProofToFile);
     _printProofToFile.tag(OptionTag::OUTPUT);
 
+    _proofTrace = StringOptionValue("proof_trace","","");
+    _proofTrace.description="Append the inferences of clauses entering passive to a trace in the here specified file and drop the links to their premises, so that clauses are not kept in memory just because they might appear in a proof. The proof is reconstructed from the trace once a refutation is found. Derivations are no longer available in memory, so answer extraction, unsat cores and interpolants do not work in this mode. The proof steps are stored in the format given by the proof option, except that proof=property is not supported. In portfolio and batch modes, each strategy process traces to a file of its own, named by the given one extended by its process id and removed as soon as it is open.";
+    _lookup.insert(&_proofTrace);
+    _proofTrace.tag(OptionTag::OUTPUT);
+    _proofTrace.onlyUsefulWith(_proof.is(notEqual(Proof::OFF)));
+    _proofTrace.addHardConstraint(If(notEqual(vstring(""))).then(_proof.is(notEqual(Proof::PROPERTY))));
+    _proofTrace.setExperimental();
+
     _proofExtra = ChoiceOptionValue<ProofExtra>("proof_extra","",ProofExtra::OFF,{"off","free","full"});
     _proofExtra.description="Add extra detail to proofs:\n "
       "- free uses known information only\n" 
@@ -353,11 +381,42 @@ void Options::init()
     _timeLimitInDeciseconds.description="Time limit in wall clock seconds, you can use d,s,m,h,D suffixes also i.e. 60s, 5m. Setting it to 0 effectively gives no time limit.";
     _lookup.insert(&_timeLimitInDeciseconds);
 
+    _inferenceRuleStatistics = BoolOptionValue("inference_rule_statistics","irstat",false);
+    _inferenceRuleStatistics.description="Measure for every inference rule how many clauses it generated, how many of them were retained and activated, and how much time was spent deriving them. The numbers are printed as a line of JSON after the statistics.";
+    _lookup.insert(&_inferenceRuleStatistics);
+    _inferenceRuleStatistics.tag(OptionTag::OUTPUT);
+
+    _hardwareCounters = BoolOptionValue("hardware_counters","hwc",false);
+    _hardwareCounters.description="Count cpu cycles, instructions, cache misses, branch misses and dTLB misses (using perf_event on Linux) separately for the unprocessed loop, activation, backward simplification and AVATAR, and print them with the statistics. In portfolio mode every slice reports its own numbers.";
+    _lookup.insert(&_hardwareCounters);
+    _hardwareCounters.tag(OptionTag::OUTPUT);
+
 #if VTIME_PROFILING
     _timeStatistics = BoolOptionValue("time_statistics","tstat",false);
     _timeStatistics.description="Show how much running time was spent in each part of Vampire";
     _lookup.insert(&_timeStatistics);
     _timeStatistics.tag(OptionTag::OUTPUT);
+
+    _timeTraceFile = StringOptionValue("time_trace_file","","");
+    _timeTraceFile.description="Append the time trace to the here specified file when the run ends. "
+      "The file is truncated on startup and every process of a portfolio run appends its own trace to it, so that the traces of all the strategies end up in one file.";
+    _lookup.insert(&_timeTraceFile);
+    _timeTraceFile.tag(OptionTag::OUTPUT);
+
+    _timeTraceFormat = ChoiceOptionValue<TimeTraceFormat>("time_trace_format","",TimeTraceFormat::COLLAPSED,{"collapsed","chrome"});
+    _timeTraceFormat.description=
+      "Format of the time trace written to time_trace_file:\n"
+      "- collapsed writes one line per call path with its self time in microseconds, as read by flamegraph.pl and speedscope\n"
+      "- chrome writes trace events, one track per process, as read by chrome://tracing and Perfetto";
+    _lookup.insert(&_timeTraceFormat);
+    _timeTraceFormat.tag(OptionTag::OUTPUT);
+    _timeTraceFormat.onlyUsefulWith(_timeTraceFile.is(notEqual(vstring(""))));
+
+    _timeTraceSampling = UnsignedOptionValue("time_trace_sampling","",0);
+    _timeTraceSampling.description="If non-zero, the time trace does not read the clock on entering and leaving every traced block, "
+      "but samples the innermost open block every so many microseconds of cpu time instead. Durations are then estimates, but the overhead no longer depends on how often the blocks are entered.";
+    _lookup.insert(&_timeTraceSampling);
+    _timeTraceSampling.tag(OptionTag::OUTPUT);
 #endif // VTIME_PROFILING
 
 //*********************** Input  ***********************
@@ -693,6 +752,11 @@ void Options::init()
     _exportThiProblem.tag(OptionTag::DEVELOPMENT);
     _exportThiProblem.onlyUsefulWith(_theoryInstAndSimp.is(notEqual(TheoryInstSimp::OFF)));
 
+    _z3CacheLimit = UnsignedOptionValue("z3_cache_limit","",100000);
+    _z3CacheLimit.description="The number of literal translations and of named constants that each Z3 solver keeps cached. Above it the cache is emptied and refilled on demand. 0 means unbounded.";
+    _lookup.insert(&_z3CacheLimit);
+    _z3CacheLimit.tag(OptionTag::DEVELOPMENT);
+
 #endif
 
     _showFOOL = BoolOptionValue("show_fool","",false);
@@ -1064,6 +1128,12 @@ void Options::init()
     _lookup.insert(&_sineToAge);
     _sineToAge.tag(OptionTag::SATURATION);
 
+    _stagedInput = BoolOptionValue("staged_input","sti",false);
+    _stagedInput.description = "Use SInE levels to add the input clauses to proof search in stages, those closest to the conjecture first. The next stage is added when the passive clauses run out or when as many clauses have been activated as have been added so far. Saves processing the whole input before the first activation when only a small part of it is needed.";
+    _stagedInput.onlyUsefulWith(InferencingSaturationAlgorithm());
+    _lookup.insert(&_stagedInput);
+    _stagedInput.tag(OptionTag::SATURATION);
+
     _randomAWR = BoolOptionValue("random_awr","rawr",false);
     _randomAWR.description = "Respecting age_weight_ratio, always choose the next clause selection queue probabilistically (rather than deterministically).";
     _lookup.insert(&_randomAWR);
@@ -1087,7 +1157,8 @@ void Options::init()
     _sineToAgeGeneralityThreshold.onlyUsefulWith(Or(
       _sineToAge.is(equal(true)),
       _sineToPredLevels.is(notEqual(PredicateSineLevels::OFF)),
-      _useSineLevelSplitQueues.is(equal(true))));
+      _useSineLevelSplitQueues.is(equal(true)),
+      _stagedInput.is(equal(true))));
 
     // Like generality threshold for SiNE, except used by the sine2age trick
     _sineToAgeTolerance = FloatOptionValue("sine_to_age_tolerance","s2at",1.0);
@@ -1099,7 +1170,8 @@ void Options::init()
     _sineToAgeTolerance.onlyUsefulWith(Or(
       _sineToAge.is(equal(true)),
       _sineToPredLevels.is(notEqual(PredicateSineLevels::OFF)),
-      _useSineLevelSplitQueues.is(equal(true))));
+      _useSineLevelSplitQueues.is(equal(true)),
+      _stagedInput.is(equal(true))));
     _sineToAgeTolerance.setRandomChoices({"1.0","1.2","1.5","2.0","3.0","5.0"});
 
     _lrsFirstTimeCheck = IntOptionValue("lrs_first_time_check","",5);
@@ -1215,6 +1287,12 @@ void Options::init()
     _inequalityNormalization.addProblemConstraint(hasTheories());
     _inequalityNormalization.tag(OptionTag::INFERENCES);
 
+    _batchGroundEvaluation = BoolOptionValue("batch_ground_evaluation","bge",false);
+    _batchGroundEvaluation.description="With the simple evaluation, evaluate the ground comparisons of numerals, unary minus, +, - and * in a clause in one pass over a compiled representation, without building the intermediate terms.";
+    _lookup.insert(&_batchGroundEvaluation);
+    _batchGroundEvaluation.addProblemConstraint(hasTheories());
+    _batchGroundEvaluation.tag(OptionTag::INFERENCES);
+
     auto choiceArithmeticSimplificationMode = [&](vstring l, vstring s, ArithmeticSimplificationMode d)
     { return ChoiceOptionValue<ArithmeticSimplificationMode>(l,s,d, {"force", "cautious", "off", }); };
     _cancellation = choiceArithmeticSimplificationMode(
@@ -1296,6 +1374,12 @@ void Options::init()
     _evaluationMode.tag(OptionTag::SATURATION);
     _evaluationMode.setExperimental();
 
+    _arithmeticMemoLimit = UnsignedOptionValue("arithmetic_memo_limit","",100000);
+    _arithmeticMemoLimit.description="The maximal number of entries in each of the tables that cache normalised and evaluated arithmetic terms. When a table is full, the entries not used since it was last full are evicted. 0 means unbounded.";
+    _lookup.insert(&_arithmeticMemoLimit);
+    _arithmeticMemoLimit.addProblemConstraint(hasTheories());
+    _arithmeticMemoLimit.tag(OptionTag::SATURATION);
+
     _induction = ChoiceOptionValue<Induction>("induction","ind",Induction::NONE,
                       {"none","struct","int","both"});
     _induction.description = "Apply structural and/or integer induction on datatypes and integers.";
@@ -1984,6 +2068,12 @@ void Options::init()
     _instGenRestartPeriod.onlyUsefulWith(_saturationAlgorithm.is(equal(SaturationAlgorithm::INST_GEN)));
     _instGenRestartPeriod.setRandomChoices({"100","200","400","700","1000","1400","2000","4000"});
 
+    _instGenIncrementalRestart = BoolOptionValue("inst_gen_incremental_restart","igir",false);
+    _instGenIncrementalRestart.description="When restarting with the current clauses, only forget the selection and move the active clauses back to passive, keeping the variant index and without grounding the clauses into the SAT solver again.";
+    _lookup.insert(&_instGenIncrementalRestart);
+    _instGenIncrementalRestart.tag(OptionTag::INST_GEN);
+    _instGenIncrementalRestart.onlyUsefulWith(_saturationAlgorithm.is(equal(SaturationAlgorithm::INST_GEN)));
+
     _instGenRestartPeriodQuotient = FloatOptionValue("inst_gen_restart_period_quotient","igrpq",1.0);
     _instGenRestartPeriodQuotient.description="Restart period is multiplied by this number after each restart.";
     _lookup.insert(&_instGenRestartPeriodQuotient);
@@ -3250,7 +3340,6 @@ void Options::readOptionsString(vstring optionsString,bool assign)
         USER_ERROR("option "+param+" not known");
         break;
       case IgnoreMissing::WARN:
-        env.beginOutput();
         if (outputAllowed()) {
           env.beginOutput();
           addCommentSignForSZS(env.out());
@@ -3432,6 +3521,54 @@ vstring Options::generateEncodedOptions() const
   return res.str();
 }
 
+/**
+ * Return a string that is the same for two option sets whenever
+ * preprocessing the same problem under them gives the same result.
+ *
+ * It lists the options read by Preprocess and by the transformations it calls,
+ * leaving out those that only control what gets printed. The random seed only
+ * counts when the portfolio workers do not get their own seeds anyway.
+ */
+vstring Options::preprocessingKey() const
+{
+  CALL("Options::preprocessingKey");
+
+  BYPASSING_ALLOCATOR;
+
+  const AbstractOptionValue* read[] = {
+    // Preprocess itself
+    &_guessTheGoal, &_guessTheGoalLimit, &_questionAnswering, &_stagedInput,
+    &_sineSelection, &_sineDepth, &_sineTolerance, &_sineGeneralityThreshold,
+    &_sineToAge, &_sineToAgeTolerance, &_sineToAgeGeneralityThreshold,
+    &_sineToPredLevels, &_useSineLevelSplitQueues,
+    &_naming, &_newCNF, &_shuffleInput, &_randomPolarities,
+    &_equalityProxy, &_useMonoEqualityProxy, &_tweeGoalTransformation,
+    &_functionDefinitionElimination, &_definitionReuse, &_unusedPredicateDefinitionRemoval,
+    &_theoryFlattening, &_theoryAxioms, &_normalize, &_inequalitySplitting,
+    &_generalSplitting, &_equalityResolutionWithDeletion, &_blockedClauseElimination,
+    &_functionExtensionality, &_choiceReasoning, &_choiceAxiom, &_addProxyAxioms, &_addCombAxioms,
+    // TheoryAxioms
+    &_FOOLParamodulation, &_cases, &_casesSimp, &_termAlgebraCyclicityCheck,
+    // FOOLElimination and NewCNF
+    &_clausificationOnTheFly, &_equalityToEquivalence, &_inlineLet, &_skolemReuse,
+    // FunctionDefinition and the protected symbols of the Signature
+    &_ignoreConjectureInPreprocessing, &_protectedPrefix,
+    // DistinctGroupExpansion
+    &_saturationAlgorithm,
+    // term ids
+    &_randomTraversals,
+  };
+
+  vostringstream res;
+  for (const AbstractOptionValue* option : read) {
+    res << option->longName << "=" << option->getStringOfActual() << ":";
+  }
+  if (!randomizeSeedForPortfolioWorkers()) {
+    res << _randomSeed.longName << "=" << _randomSeed.getStringOfActual() << ":";
+  }
+  return res.str();
+}
+
 
 /**
  * True if the options are complete.
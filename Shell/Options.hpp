@@ -131,6 +131,7 @@ public:
     void readFromEncodedOptions (vstring testId);
     void readOptionsString (vstring testId,bool assign=true);
     vstring generateEncodedOptions() const;
+    vstring preprocessingKey() const;
 
     // deal with completeness
     bool complete(const Problem&) const;
@@ -563,6 +564,12 @@ public:
     OFF = 2
   };
 
+  /** Values for --time_trace_format */
+  enum class TimeTraceFormat : unsigned int {
+    COLLAPSED = 0,
+    CHROME = 1
+  };
+
   enum class Proof : unsigned int {
     OFF = 0,
     ON = 1,
@@ -2077,6 +2084,7 @@ public:
   bool minimizeSatProofs() const { return _minimizeSatProofs.actualValue; }
   ProofExtra proofExtra() const { return _proofExtra.actualValue; }
   vstring printProofToFile() const { return _printProofToFile.actualValue; }
+  vstring proofTrace() const { return _proofTrace.actualValue; }
   int naming() const { return _naming.actualValue; }
 
   bool fmbNonGroundDefs() const { return _fmbNonGroundDefs.actualValue; }
@@ -2094,6 +2102,8 @@ public:
   bool flattenTopLevelConjunctions() const { return _flattenTopLevelConjunctions.actualValue; }
   LTBLearning ltbLearning() const { return _ltbLearning.actualValue; }
   vstring ltbDirectory() const { return _ltbDirectory.actualValue; }
+  unsigned ltbConcurrentProblems() const { return _ltbConcurrentProblems.actualValue; }
+  bool ltbSharedSine() const { return _ltbSharedSine.actualValue; }
   Mode mode() const { return _mode.actualValue; }
   Schedule schedule() const { return _schedule.actualValue; }
   vstring scheduleName() const { return _schedule.getStringOfValue(_schedule.actualValue); }
@@ -2127,6 +2137,7 @@ public:
   bool showDefinitions() const { return showAll() || _showDefinitions.actualValue; }
   bool showNew() const { return showAll() || _showNew.actualValue; }
   bool sineToAge() const { return _sineToAge.actualValue; }
+  bool stagedInput() const { return _stagedInput.actualValue; }
   PredicateSineLevels sineToPredLevels() const { return _sineToPredLevels.actualValue; }
   bool showSplitting() const { return showAll() || _showSplitting.actualValue; }
   bool showNewPropositional() const { return showAll() || _showNewPropositional.actualValue; }
@@ -2145,6 +2156,7 @@ public:
   bool showZ3() const { return showAll() || _showZ3.actualValue; }
   vstring const& exportAvatarProblem() const { return _exportAvatarProblem.actualValue; }
   vstring const& exportThiProblem() const { return _exportThiProblem.actualValue; }
+  unsigned z3CacheLimit() const { return _z3CacheLimit.actualValue; }
 #endif
   
   // end of show commands
@@ -2232,6 +2244,7 @@ public:
   int timeLimitInDeciseconds() const { return _timeLimitInDeciseconds.actualValue; }
   size_t memoryLimit() const { return _memoryLimit.actualValue; }
   void setMemoryLimitOptionValue(size_t newVal) { _memoryLimit.actualValue = newVal; }
+  bool hugePages() const { return _hugePages.actualValue; }
 #ifdef __linux__
   unsigned instructionLimit() const { return _instructionLimit.actualValue; }
   void setInstructionLimit(unsigned newVal) { _instructionLimit.actualValue = newVal; }
@@ -2285,6 +2298,7 @@ public:
   bool randomTraversals() const { return _randomTraversals.actualValue; }
   bool randomizeSeedForPortfolioWorkers() const { return _randomizSeedForPortfolioWorkers.actualValue; }
   void setRandomizeSeedForPortfolioWorkers(bool val) { _randomizSeedForPortfolioWorkers.actualValue = val; }
+  bool preprocessingZygotes() const { return _preprocessingZygotes.actualValue; }
 
   bool ignoreConjectureInPreprocessing() const {return _ignoreConjectureInPreprocessing.actualValue;}
 
@@ -2315,7 +2329,12 @@ public:
   bool generalSplitting() const { return _generalSplitting.actualValue; }
 #if VTIME_PROFILING
   bool timeStatistics() const { return _timeStatistics.actualValue; }
+  vstring timeTraceFile() const { return _timeTraceFile.actualValue; }
+  TimeTraceFormat timeTraceFormat() const { return _timeTraceFormat.actualValue; }
+  unsigned timeTraceSampling() const { return _timeTraceSampling.actualValue; }
 #endif // VTIME_PROFILING
+  bool inferenceRuleStatistics() const { return _inferenceRuleStatistics.actualValue; }
+  bool hardwareCounters() const { return _hardwareCounters.actualValue; }
   bool splitting() const { return _splitting.actualValue; }
   void setSplitting(bool value){ _splitting.actualValue=value; }
   bool nonliteralsInClauseWeight() const { return _nonliteralsInClauseWeight.actualValue; }
@@ -2355,6 +2374,7 @@ public:
   int instGenResolutionRatioInstGen() const { return _instGenResolutionInstGenRatio.actualValue; }
   int instGenResolutionRatioResolution() const { return _instGenResolutionInstGenRatio.otherValue; }
   int instGenRestartPeriod() const { return _instGenRestartPeriod.actualValue; }
+  bool instGenIncrementalRestart() const { return _instGenIncrementalRestart.actualValue; }
   float instGenRestartPeriodQuotient() const { return _instGenRestartPeriodQuotient.actualValue; }
   int instGenSelection() const { return _instGenSelection.actualValue; }
   bool instGenWithResolution() const { return _instGenWithResolution.actualValue; }
@@ -2386,6 +2406,8 @@ public:
   bool useManualClauseSelection() const { return _manualClauseSelection.actualValue; }
   bool inequalityNormalization() const { return _inequalityNormalization.actualValue; }
   EvaluationMode evaluationMode() const { return _highSchool.actualValue ? EvaluationMode::POLYNOMIAL_CAUTIOUS : _evaluationMode.actualValue; }
+  unsigned arithmeticMemoLimit() const { return _arithmeticMemoLimit.actualValue; }
+  bool batchGroundEvaluation() const { return _batchGroundEvaluation.actualValue; }
   ArithmeticSimplificationMode gaussianVariableElimination() const { return _highSchool.actualValue ? ArithmeticSimplificationMode::CAUTIOUS : _gaussianVariableElimination.actualValue; }
   bool pushUnaryMinus() const { return _pushUnaryMinus.actualValue || _highSchool.actualValue; }
   ArithmeticSimplificationMode cancellation() const { return _highSchool.actualValue ? ArithmeticSimplificationMode::CAUTIOUS : _cancellation.actualValue; }
@@ -2642,6 +2664,7 @@ private:
   RatioOptionValue _instGenResolutionInstGenRatio;
   //IntOptionValue _instGenResolutionRatioResolution;
   IntOptionValue _instGenRestartPeriod;
+  BoolOptionValue _instGenIncrementalRestart;
   FloatOptionValue _instGenRestartPeriodQuotient;
   BoolOptionValue _instGenWithResolution;
   BoolOptionValue _useHashingVariantIndex;
@@ -2673,6 +2696,8 @@ private:
   BoolOptionValue _lrsWeightLimitOnly;
   ChoiceOptionValue<LTBLearning> _ltbLearning;
   StringOptionValue _ltbDirectory;
+  UnsignedOptionValue _ltbConcurrentProblems;
+  BoolOptionValue _ltbSharedSine;
 
 #ifdef __linux__
   UnsignedOptionValue _instructionLimit; 
@@ -2680,12 +2705,14 @@ private:
 #endif
 
   UnsignedOptionValue _memoryLimit; // should be size_t, making an assumption
+  BoolOptionValue _hugePages;
   ChoiceOptionValue<Mode> _mode;
   ChoiceOptionValue<Schedule> _schedule;
   StringOptionValue _scheduleFile;
   UnsignedOptionValue _multicore;
   FloatOptionValue _slowness;
   BoolOptionValue _randomizSeedForPortfolioWorkers;
+  BoolOptionValue _preprocessingZygotes;
 
   IntOptionValue _naming;
   BoolOptionValue _nonliteralsInClauseWeight;
@@ -2696,6 +2723,7 @@ private:
   BoolOptionValue _outputAxiomNames;
 
   StringOptionValue _printProofToFile;
+  StringOptionValue _proofTrace;
   BoolOptionValue _printClausifierPremises;
   StringOptionValue _problemName;
   ChoiceOptionValue<Proof> _proof;
@@ -2720,6 +2748,7 @@ private:
   ChoiceOptionValue<InterpolantMode> _showInterpolant;
   BoolOptionValue _showNew;
   BoolOptionValue _sineToAge;
+  BoolOptionValue _stagedInput;
   ChoiceOptionValue<PredicateSineLevels> _sineToPredLevels;
   BoolOptionValue _showSplitting;
   BoolOptionValue _showNewPropositional;
@@ -2744,6 +2773,7 @@ private:
   BoolOptionValue _showZ3;
   StringOptionValue _exportAvatarProblem;
   StringOptionValue _exportThiProblem;
+  UnsignedOptionValue _z3CacheLimit;
   BoolOptionValue _satFallbackForSMT;
   BoolOptionValue _smtForGround;
   ChoiceOptionValue<TheoryInstSimp> _theoryInstAndSimp;
@@ -2786,6 +2816,8 @@ private:
   ChoiceOptionValue<SymbolPrecedenceBoost> _symbolPrecedenceBoost;
   ChoiceOptionValue<IntroducedSymbolPrecedence> _introducedSymbolPrecedence;
   ChoiceOptionValue<EvaluationMode> _evaluationMode;
+  UnsignedOptionValue _arithmeticMemoLimit;
+  BoolOptionValue _batchGroundEvaluation;
   ChoiceOptionValue<KboWeightGenerationScheme> _kboWeightGenerationScheme;
   BoolOptionValue _kboMaxZero;
   ChoiceOptionValue<KboAdmissibilityCheck> _kboAdmissabilityCheck;
@@ -2805,6 +2837,11 @@ private:
   /** Time limit in deciseconds */
   TimeLimitOptionValue _timeLimitInDeciseconds;
   BoolOptionValue _timeStatistics;
+  BoolOptionValue _inferenceRuleStatistics;
+  BoolOptionValue _hardwareCounters;
+  StringOptionValue _timeTraceFile;
+  ChoiceOptionValue<TimeTraceFormat> _timeTraceFormat;
+  UnsignedOptionValue _timeTraceSampling;
 
   ChoiceOptionValue<URResolution> _unitResultingResolution;
   BoolOptionValue _unusedPredicateDefinitionRemoval;
@@ -183,7 +183,8 @@ void Preprocess::preprocess(Problem& prb)
     DistinctGroupExpansion().apply(prb);
   }
 
-  if (_options.sineToAge() || _options.useSineLevelSplitQueues() || (_options.sineToPredLevels() != Options::PredicateSineLevels::OFF)) {
+  if (_options.sineToAge() || _options.useSineLevelSplitQueues() || _options.stagedInput() ||
+      (_options.sineToPredLevels() != Options::PredicateSineLevels::OFF)) {
     env.statistics->phase=Statistics::SINE_SELECTION;
 
     if (_options.sineToPredLevels() != Options::PredicateSineLevels::OFF) {
@@ -253,6 +254,13 @@ void Preprocess::preprocess(Problem& prb)
     pdRemover.removeUnusedDefinitionsAndPurePredicates(prb);
   }
 
+  // without shuffling in between and with the symbols of naming and
+  // skolemisation kept apart, the formula passes can run unit by unit
+  if (prb.mayHaveFormulas() && !_options.shuffleInput() &&
+      !prb.hasPolymorphicSym() && !prb.higherOrder() && !env.options->showPreprocessing()) {
+    formulasToClauses(prb);
+  }
+
   if (prb.mayHaveFormulas()) {
     if (env.options->showPreprocessing())
       env.out() << "preprocess 2 (ennf,flatten)" << std::endl;
@@ -562,6 +570,108 @@ void Preprocess::preprocess2(Problem& prb)
   }
 } // Peprocess::preprocess2
 
+/**
+ * Take every formula of @c prb through preprocess2 and then either NewCNF or
+ * naming, preprocess3 and clausification before moving on to the next one,
+ * instead of running each of these passes over the whole problem in turn.
+ * This way a formula is still in cache when the next pass gets to it.
+ *
+ * The resulting clauses come in the same order as from the separate passes.
+ * So do the introduced symbols, provided the problem is first-order and
+ * monomorphic: names are then predicates and Skolem symbols functions, and
+ * either kind is introduced in the order of the units.
+ */
+void Preprocess::formulasToClauses(Problem& prb)
+{
+  CALL("Preprocess::formulasToClauses");
+  ASS(!prb.higherOrder());
+  ASS(!prb.hasPolymorphicSym());
+
+  //we check if we haven't discovered an empty clause during preprocessing
+  Unit* emptyClause = 0;
+
+  bool modified = false;
+
+  UnitList::DelIterator us(prb.units());
+  Naming naming(_options.naming(),false,false);
+  NewCNF newCnf(_options.naming());
+  CNF cnf;
+  Stack<Clause*> clauses(32);
+  while (us.hasNext()) {
+    Unit* u = us.next();
+    if (u->isClause()) {
+      if (static_cast<Clause*>(u)->isEmpty()) {
+        emptyClause = u;
+        break;
+      }
+      continue;
+    }
+    modified = true;
+
+    env.statistics->phase=Statistics::PREPROCESS_2;
+    FormulaUnit* fu = NNF::ennf(static_cast<FormulaUnit*>(u));
+    fu = Flattening::flatten(fu);
+
+    if (_options.newCNF()) {
+      env.statistics->phase=Statistics::NEW_CNF;
+      newCnf.clausify(fu,clauses);
+      while (! clauses.isEmpty()) {
+        Clause* cl = clauses.pop();
+        if (cl->isEmpty()) {
+          emptyClause = cl;
+          goto fin;
+        }
+        us.insert(cl);
+      }
+      us.del();
+      continue;
+    }
+
+    // the definitions come before the named formula, as in naming(Problem&)
+    UnitList* formulas = 0;
+    if (_options.naming()) {
+      env.statistics->phase=Statistics::NAMING;
+      UnitList* defs;
+      FormulaUnit* v = naming.apply(fu,defs);
+      if (v != fu) {
+        ASS(defs || env.options->definitionReuse());
+        formulas = defs;
+        fu = v;
+      }
+    }
+    formulas = UnitList::concat(formulas, new UnitList(fu));
+
+    UnitList::Iterator fit(formulas);
+    while (fit.hasNext()) {
+      env.statistics->phase=Statistics::PREPROCESS_3;
+      Unit* f = preprocess3(fit.next(), false);
+      env.statistics->phase=Statistics::CLAUSIFICATION;
+      cnf.clausify(f,clauses);
+      while (! clauses.isEmpty()) {
+        Clause* cl = clauses.pop();
+        if (cl->isEmpty()) {
+          UnitList::destroy(formulas);
+          emptyClause = cl;
+          goto fin;
+        }
+        us.insert(cl);
+      }
+    }
+    UnitList::destroy(formulas);
+    us.del();
+  }
+  fin:
+  if (emptyClause) {
+    UnitList::destroy(prb.units());
+    prb.units() = 0;
+    UnitList::push(emptyClause, prb.units());
+  }
+  if (modified) {
+    prb.invalidateProperty();
+  }
+  prb.reportFormulasEliminated();
+} // Preprocess::formulasToClauses
+
 /**
  * Perform naming on problem @c prb which is in ENNF
  */
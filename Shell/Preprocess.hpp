@@ -48,6 +48,7 @@ public:
   void keepSimplifyStep() {_stillSimplify = true; }
 private:
   void preprocess2(Problem& prb);
+  void formulasToClauses(Problem& prb);
   void naming(Problem& prb);
   Unit* preprocess3(Unit* u, bool appify /*higher order stuff*/);
   void preprocess3(Problem& prb);
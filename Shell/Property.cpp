@@ -35,6 +35,7 @@
 #include "FunctionDefinition.hpp"
 #include "Property.hpp"
 #include "SubexpressionIterator.hpp"
+#include "TheoryFinder.hpp"
 
 using namespace Lib;
 using namespace Kernel;
@@ -95,9 +96,11 @@ Property::Property()
 
 /**
  * Create a new property, scan the units with it and return the property.
+ * If @b findTheories is set, the units are also matched against
+ * the known theory axioms in the same pass, see TheoryFinder.
  * @since 22/07/2011 Manchester
  */
-Property* Property::scan(UnitList* units)
+Property* Property::scan(UnitList* units, bool findTheories)
 {
   CALL("Property::scan");
 
@@ -112,7 +115,13 @@ Property* Property::scan(UnitList* units)
    }
 
   Property* prop = new Property;
-  prop->add(units);
+  if (findTheories) {
+    TheoryFinder theories(units,prop);
+    prop->add(units,&theories);
+  }
+  else {
+    prop->add(units);
+  }
   return prop;
 } // Property::scan
 
@@ -128,16 +137,31 @@ Property::~Property()
 }
 
 /**
- * Add units and modify an existing property.
+ * Add units and modify an existing property. If @b theories is given,
+ * each unit is also matched against the known theory axioms right after
+ * it is scanned, saving TheoryFinder::search() its own pass over the units.
  * @since 29/06/2002 Manchester
  */
-void Property::add(UnitList* units)
+void Property::add(UnitList* units, TheoryFinder* theories)
 {
   CALL("Property::add(UnitList*)");
 
+  // properties set by the theory finder, which cannot cope with
+  // polymorphic input; so they are only kept if no polymorphism is seen
+  uint64_t theoryProps = 0;
+
   UnitList::Iterator us(units);
   while (us.hasNext()) {
-    scan(us.next());
+    Unit* unit = us.next();
+    scan(unit);
+    if (theories && !_hasPolymorphicSym) {
+      uint64_t props = _props;
+      theories->matchAll(unit);
+      theoryProps |= _props & ~props;
+    }
+  }
+  if (_hasPolymorphicSym) {
+    dropProp(theoryProps);
   }
 
   if (_allClausesGround && _allQuantifiersEssentiallyExistential) {
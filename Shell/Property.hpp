@@ -43,6 +43,8 @@ using namespace std;
 using namespace Kernel;
 using namespace Lib;
 
+class TheoryFinder;
+
 /**
  * Represents syntactic properties of problems.
  */
@@ -158,8 +160,8 @@ public:
 
   // constructor, operators new and delete
   explicit Property();
-  static Property* scan(UnitList*);
-  void add(UnitList*);
+  static Property* scan(UnitList*, bool findTheories=false);
+  void add(UnitList*, TheoryFinder* theories=0);
   ~Property();
 
   /** Return the CASC category of the problem */
@@ -239,6 +239,19 @@ SineSymbolExtractor::SymIdIterator SineSymbolExtractor::extractSymIds(Unit* u)
 {
   CALL("SineSymbolExtractor::extractSymIds");
 
+  Stack<SymId> ids;
+  extractSymIds(u,ids);
+  return pvi(ownedArrayishIterator(std::move(ids)));
+}
+
+/**
+ * Push SymIds of symbols in a unit on @b ids, in ascending order.
+ * Each SymId is pushed at most once.
+ */
+void SineSymbolExtractor::extractSymIds(Unit* u, Stack<SymId>& ids)
+{
+  CALL("SineSymbolExtractor::extractSymIds/2");
+
   static DHSet<SymId> itms;
   itms.reset();
 
@@ -253,11 +266,32 @@ SineSymbolExtractor::SymIdIterator SineSymbolExtractor::extractSymIds(Unit* u)
     FormulaUnit* fu=static_cast<FormulaUnit*>(u);
     extractFormulaSymbols(fu->formula(),itms);
   }
-  Stack<SymId> ids(itms.size());
+  size_t first=ids.size();
+  ids.reserve(first+itms.size());
   DHSet<SymId>::Iterator iter(itms);
   ids.loadFromIterator(iter);
-  std::sort(ids.begin(), ids.end()); // <- make order deterministic
-  return pvi(ownedArrayishIterator(std::move(ids)));
+  std::sort(ids.begin()+first, ids.end()); // <- make order deterministic
+}
+
+/**
+ * Extract the symbols of all @b units
+ */
+void SineOccurrenceIndex::build(UnitList* units, SineSymbolExtractor& extr)
+{
+  CALL("SineOccurrenceIndex::build");
+
+  _units.reset();
+  _start.reset();
+  _syms.reset();
+
+  UnitList::Iterator uit(units);
+  while (uit.hasNext()) {
+    Unit* u=uit.next();
+    _units.push(u);
+    _start.push(_syms.size());
+    extr.extractSymIds(u,_syms);
+  }
+  _start.push(_syms.size());
 }
 
 void SineBase::initGeneralityFunction(UnitList* units)
@@ -278,6 +312,20 @@ void SineBase::initGeneralityFunction(UnitList* units)
   }
 }
 
+void SineBase::initGeneralityFunction(const SineOccurrenceIndex& occ)
+{
+  CALL("SineBase::initGeneralityFunction/occ");
+
+  SymId symIdBound=_symExtr.getSymIdBound();
+  _gen.init(symIdBound,0);
+
+  for (unsigned i=0;i<occ.size();i++) {
+    for (const SymId* sit=occ.symBegin(i); sit!=occ.symEnd(i); sit++) {
+      _gen[*sit]++;
+    }
+  }
+}
+
 SineSelector::SineSelector(const Options& opt)
 : _onIncluded(opt.sineSelection()==Options::SineSelection::INCLUDED),
   _genThreshold(opt.sineGeneralityThreshold()),
@@ -311,15 +359,17 @@ void SineSelector::init()
 }
 
 /**
- * Connect unit @b u with symbols it defines
+ * Connect the unit with index @b unitIdx in @b _occ with symbols it defines
  */
-void SineSelector::updateDefRelation(Unit* u)
+void SineSelector::updateDefRelation(unsigned unitIdx)
 {
   CALL("SineSelector::updateDefRelation");
 
-  SymIdIterator sit=_symExtr.extractSymIds(u);
+  const SymId* symBegin=_occ.symBegin(unitIdx);
+  const SymId* symEnd=_occ.symEnd(unitIdx);
 
-  if (!sit.hasNext()) {
+  if (symBegin==symEnd) {
+    Unit* u=_occ.unit(unitIdx);
     if(_justForSineLevels){
       u->inference().setSineLevel(0);
       //cout << "set level for a non-symboler " << u->toString() << " as " << "(0)" << endl;
@@ -331,22 +381,23 @@ void SineSelector::updateDefRelation(Unit* u)
   static Stack<SymId> equalGenerality;
   equalGenerality.reset();
 
-  SymId leastGenSym=sit.next();
+  const SymId* sit=symBegin;
+  SymId leastGenSym=*sit++;
   unsigned leastGenVal=_gen[leastGenSym];
 
   //it a symbol fits under _genThreshold, add it immediately [into the relation]
   if (leastGenVal<=_genThreshold) {
-    UnitList::push(u,_def[leastGenSym]);
+    addToDefRelation(leastGenSym,unitIdx);
   }
 
-  while (sit.hasNext()) {
-    SymId sym=sit.next();
+  for (;sit!=symEnd;sit++) {
+    SymId sym=*sit;
     unsigned val=_gen[sym];
     ASS_G(val,0);
 
     //it a symbol fits under _genThreshold, add it immediately [into the relation]
     if (val<=_genThreshold) {
-      UnitList::push(u,_def[sym]);
+      addToDefRelation(sym,unitIdx);
     }
 
     if (val<leastGenVal) {
@@ -362,9 +413,9 @@ void SineSelector::updateDefRelation(Unit* u)
   if (_strict) {
     //only if the least general symbol is over _genThreshold; otherwise it is already added
     if (leastGenVal>_genThreshold) {
-      UnitList::push(u,_def[leastGenSym]);
+      addToDefRelation(leastGenSym,unitIdx);
       while (equalGenerality.isNonEmpty()) {
-        UnitList::push(u,_def[equalGenerality.pop()]);
+        addToDefRelation(equalGenerality.pop(),unitIdx);
       }
     }
   }
@@ -376,13 +427,12 @@ void SineSelector::updateDefRelation(Unit* u)
 
     //if the generalityLimit is under _genThreshold, all suitable symbols are already added
     if (generalityLimit>_genThreshold) {
-      sit=_symExtr.extractSymIds(u);
-      while (sit.hasNext()) {
-	SymId sym=sit.next();
+      for (sit=symBegin;sit!=symEnd;sit++) {
+	SymId sym=*sit;
 	unsigned val=_gen[sym];
 	//only if the symbol is over _genThreshold; otherwise it is already added
 	if (val>_genThreshold && val<=generalityLimit) {
-	  UnitList::push(u,_def[sym]);
+	  addToDefRelation(sym,unitIdx);
 	}
       }
     }
@@ -390,6 +440,40 @@ void SineSelector::updateDefRelation(Unit* u)
 
 }
 
+/**
+ * Turn the pairs collected by updateDefRelation() into the compressed
+ * D-relation in @b _defStart and @b _defUnits
+ *
+ * The units defining a symbol are stored in the reverse of the order
+ * in which they were added, which is the order in which the selection
+ * traverses them.
+ */
+void SineSelector::buildDefRelation(SymId symIdBound)
+{
+  CALL("SineSelector::buildDefRelation");
+
+  _defStart.init(symIdBound+1,0);
+  _defUnits.init(_defPairs.size(),0);
+
+  Stack<std::pair<SymId,unsigned>>::BottomFirstIterator pit(_defPairs);
+  while (pit.hasNext()) {
+    _defStart[pit.next().first]++;
+  }
+  // now make _defStart[s] point just after the last unit defining s
+  unsigned sum=0;
+  for (SymId s=0;s<=symIdBound;s++) {
+    sum+=_defStart[s];
+    _defStart[s]=sum;
+  }
+  // fill the units from the back, so that _defStart[s] ends up pointing at the first one
+  Stack<std::pair<SymId,unsigned>>::BottomFirstIterator pit2(_defPairs);
+  while (pit2.hasNext()) {
+    std::pair<SymId,unsigned> p=pit2.next();
+    _defUnits[--_defStart[p.first]]=p.second;
+  }
+  _defPairs.reset();
+}
+
 void SineSelector::perform(Problem& prb)
 {
   CALL("SineSelector::perform");
@@ -406,30 +490,34 @@ bool SineSelector::perform(UnitList*& units)
 
   TIME_TRACE(TimeTrace::SINE_SELECTION);
 
-  initGeneralityFunction(units);
+  // symbols of each unit are extracted just once and used by all the stages below
+  _occ.build(units,_symExtr);
+  initGeneralityFunction(_occ);
 
   SymId symIdBound=_symExtr.getSymIdBound();
 
-  Set<Unit*> selected;
+  // value marking the end of one selection step in newlySelected
+  static const unsigned depthMark=UINT_MAX;
+
+  DArray<bool> selected;
+  selected.init(_occ.size(),false);
   Stack<Unit*> selectedStack; //on this stack there are Units in the order they were selected
-  Deque<Unit*> newlySelected;
+  Deque<unsigned> newlySelected;
 
   //build the D-relation and select the non-axiom formulas
-  _def.init(symIdBound,0);
   unsigned numberUnitsLeftOut = 0;
-  UnitList::Iterator uit2(units);
-  while (uit2.hasNext()) {
+  for (unsigned ui=0;ui<_occ.size();ui++) {
     numberUnitsLeftOut++;
-    Unit* u=uit2.next();
+    Unit* u=_occ.unit(ui);
     bool performSelection= _onIncluded ? u->included() : ((u->inputType()==UnitInputType::AXIOM)
                             || (env.options->guessTheGoal() != Options::GoalGuess::OFF && u->inputType()==UnitInputType::ASSUMPTION));
     if (performSelection) { // register the unit for later
-      updateDefRelation(u);
+      updateDefRelation(ui);
     }
     else { // goal units are immediately taken (well, non-axiom, to by more precise. Includes ASSUMPTION, which cl->isGoal() does not take into account)
-      selected.insert(u);
+      selected[ui]=true;
       selectedStack.push(u);
-      newlySelected.push_back(u);
+      newlySelected.push_back(ui);
 
       if(_justForSineLevels) {
         u->inference().setSineLevel(0);
@@ -437,17 +525,22 @@ bool SineSelector::perform(UnitList*& units)
       }
     }
   }
+  buildDefRelation(symIdBound);
+
+  // symbols whose defining units were all selected already
+  DArray<bool> symDone;
+  symDone.init(symIdBound,false);
 
   unsigned depth=0;
-  newlySelected.push_back(0);
+  newlySelected.push_back(depthMark);
 
   // cout << "env.maxClausePriority starts as" << env.maxClausePriority << endl;
 
   //select required axiom formulas
   while (newlySelected.isNonEmpty()) {
-    Unit* u=newlySelected.pop_front();
+    unsigned ui=newlySelected.pop_front();
 
-    if (!u) {
+    if (ui==depthMark) {
       //next selected formulas will be one step further from the original formulas
       depth++;
       
@@ -464,14 +557,13 @@ bool SineSelector::perform(UnitList*& units)
 
       if (newlySelected.isNonEmpty()) {
 	//we must push another mark if we're not done yet
-	newlySelected.push_back(0);
+	newlySelected.push_back(depthMark);
       }
       continue;
     }
 
-    SymIdIterator sit=_symExtr.extractSymIds(u);
-    while (sit.hasNext()) {
-      SymId sym=sit.next();
+    for (const SymId* sit=_occ.symBegin(ui); sit!=_occ.symEnd(ui); sit++) {
+      SymId sym=*sit;
 
       if (env.predicateSineLevels) {
         bool pred;
@@ -483,15 +575,18 @@ bool SineSelector::perform(UnitList*& units)
         }
       }
 
-      UnitList::Iterator defUnits(_def[sym]);
-      while (defUnits.hasNext()) {
-        Unit* du=defUnits.next();
-        if (selected.contains(du)) {
+      if (symDone[sym]) {
+        continue;
+      }
+      for (unsigned di=_defStart[sym]; di<_defStart[sym+1]; di++) {
+        unsigned dui=_defUnits[di];
+        if (selected[dui]) {
           continue;
         }
-        selected.insert(du);
+        Unit* du=_occ.unit(dui);
+        selected[dui]=true;
         selectedStack.push(du);
-        newlySelected.push_back(du);
+        newlySelected.push_back(dui);
 
         if(_justForSineLevels){
           du->inference().setSineLevel(env.maxSineLevel);
@@ -499,9 +594,8 @@ bool SineSelector::perform(UnitList*& units)
         }
       }
       //all defining units for the symbol sym were selected,
-      //so we can remove them from the relation
-      UnitList::destroy(_def[sym]);
-      _def[sym]=0;
+      //so we don't need to look at them again
+      symDone[sym]=true;
     }
   }
 
@@ -646,6 +740,23 @@ void SineTheorySelector::initSelectionStructure(UnitList* units)
 }
 
 
+/**
+ * Return true if the selection structure can be used to perform the SInE
+ * selection requested by @b opt
+ *
+ * This is the case if the tolerance is within the limit implied by
+ * @b maxTolerance and the generality threshold is the same as the one
+ * the structure was built with.
+ */
+bool SineTheorySelector::canSelectFor(const Options& opt) const
+{
+  CALL("SineTheorySelector::canSelectFor");
+
+  float tolerance=opt.sineTolerance();
+  return tolerance!=-1.0f && tolerance*strictTolerance<=maxTolerance
+    && opt.sineGeneralityThreshold()==_genThreshold;
+}
+
 void SineTheorySelector::perform(UnitList*& units)
 {
   CALL("SineTheorySelector::perform");
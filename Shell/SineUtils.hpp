@@ -17,6 +17,7 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/Allocator.hpp"
 #include "Lib/DArray.hpp"
 #include "Lib/Stack.hpp"
 
@@ -34,6 +35,7 @@ public:
   SymId getSymIdBound();
 
   SymIdIterator extractSymIds(Unit* u);
+  void extractSymIds(Unit* u, Stack<SymId>& ids);
 
   static void decodeSymId(SymId s, bool& pred, unsigned& functor);
   bool validSymId(SymId s);
@@ -44,6 +46,31 @@ private:
 };
 
 
+/**
+ * Symbol occurrences of a list of units in compressed sparse row form
+ *
+ * The SymIds of the i-th unit are stored (sorted and each at most once)
+ * in the range [symBegin(i),symEnd(i)) of a single array, so that the
+ * symbols of each unit need to be extracted only once.
+ */
+class SineOccurrenceIndex
+{
+public:
+  typedef SineSymbolExtractor::SymId SymId;
+
+  void build(UnitList* units, SineSymbolExtractor& extr);
+
+  unsigned size() const { return _units.size(); }
+  Unit* unit(unsigned i) const { return _units[i]; }
+  const SymId* symBegin(unsigned i) const { return _syms.begin()+_start[i]; }
+  const SymId* symEnd(unsigned i) const { return _syms.begin()+_start[i+1]; }
+private:
+  Stack<Unit*> _units;
+  /** _start[i] is the position of the first SymId of the i-th unit in _syms */
+  Stack<unsigned> _start;
+  Stack<SymId> _syms;
+};
+
 class SineBase
 {
 protected:
@@ -51,6 +78,7 @@ protected:
   typedef SineSymbolExtractor::SymIdIterator SymIdIterator;
 
   void initGeneralityFunction(UnitList* units);
+  void initGeneralityFunction(const SineOccurrenceIndex& occ);
 
   /** Stores symbol generality */
   DArray<unsigned> _gen;
@@ -72,16 +100,12 @@ public:
   bool perform(UnitList*& units); // returns true iff removed something
   void perform(Problem& prb);
 
-  ~SineSelector() {
-    DArray<UnitList*>::Iterator it(_def);
-    while (it.hasNext()) {
-      UnitList::destroy(it.next());
-    }
-  }
 private:
   void init();
 
-  void updateDefRelation(Unit* u);
+  void updateDefRelation(unsigned unitIdx);
+  void addToDefRelation(SymId sym, unsigned unitIdx) { _defPairs.push(std::make_pair(sym,unitIdx)); }
+  void buildDefRelation(SymId symIdBound);
 
   bool _onIncluded;
   bool _strict;
@@ -91,8 +115,18 @@ private:
 
   bool _justForSineLevels;
 
-  /** Stored the D-relation */
-  DArray<UnitList*> _def;
+  /** Symbols of the units being selected from */
+  SineOccurrenceIndex _occ;
+
+  /** Pairs (symbol, unit index) of the D-relation in the order they were found */
+  Stack<std::pair<SymId,unsigned>> _defPairs;
+
+  /**
+   * Stored the D-relation in compressed sparse row form: indices of units
+   * defining the symbol @b s are in _defUnits[_defStart[s]] ... _defUnits[_defStart[s+1]-1]
+   */
+  DArray<unsigned> _defStart;
+  DArray<unsigned> _defUnits;
 
   /**
    * Stored formulas that don't contain any symbols
@@ -114,10 +148,15 @@ class SineTheorySelector
 : public SineBase
 {
 public:
+  CLASS_NAME(SineTheorySelector);
+  USE_ALLOCATOR(SineTheorySelector);
+
   SineTheorySelector(const Options& opt);
 
   void initSelectionStructure(UnitList* units);
   void perform(UnitList*& units);
+
+  bool canSelectFor(const Options& opt) const;
 private:
 
   /** The integer tolerance value is the float option value multiplied by 10 and
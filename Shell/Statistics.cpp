@@ -21,6 +21,7 @@
 #include "Lib/Allocator.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Timer.hpp"
+#include "Kernel/Inference.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "Shell/UIHelper.hpp"
@@ -70,6 +71,8 @@ Statistics::Statistics()
     theoryInstSimpTautologies(0),
     theoryInstSimpLostSolution(0),
     theoryInstSimpEmptySubstitution(0),
+    z3TranslationReuse(0),
+    z3CacheFlushes(0),
     maxInductionDepth(0),
     structInduction(0),
     structInductionInProof(0),
@@ -95,6 +98,7 @@ Statistics::Statistics()
     inductionApplicationInProof(0),
     generalizedInductionApplication(0),
     generalizedInductionApplicationInProof(0),
+    inductionFormulaReuse(0),
     argumentCongruence(0),
     narrow(0),
     forwardSubVarSup(0),
@@ -132,6 +136,10 @@ Statistics::Statistics()
     evaluationIncomp(0),
     evaluationGreater(0),
     evaluationCnt(0),
+    arithmeticMemoHits(0),
+    arithmeticMemoMisses(0),
+    arithmeticMemoEvictions(0),
+    batchEvaluatedLiterals(0),
     innerRewrites(0),
     innerRewritesToEqTaut(0),
     deepEquationalTautologies(0),
@@ -153,6 +161,9 @@ Statistics::Statistics()
     smtReturnedUnknown(false),
     smtDidNotEvaluate(false),
     inferencesSkippedDueToColors(0),
+    unattributedForwardSimplificationTime(0),
+    unattributedBackwardSimplificationTime(0),
+    unattributedGeneratingInferenceTime(0),
     finalPassiveClauses(0),
     finalActiveClauses(0),
     finalExtensionalityClauses(0),
@@ -179,8 +190,47 @@ Statistics::Statistics()
     saturatedSet(0),
     phase(INITIALIZATION)
 {
+  inferenceRuleCosts.init(toNumber(InferenceRule::EXTERNAL_THEORY_AXIOM) + 1, InferenceRuleCost{0, 0, 0, 0});
 } // Statistics::Statistics
 
+Statistics::InferenceRuleCost& Statistics::inferenceRuleCost(InferenceRule rule)
+{
+  return inferenceRuleCosts[toNumber(rule)];
+}
+
+/**
+ * Print the costs of the inference rules as a single line of JSON, so that
+ * it can be picked out of the output and compared across runs.
+ */
+void Statistics::printInferenceRuleCosts(ostream& out)
+{
+  CALL("Statistics::printInferenceRuleCosts");
+
+  auto us = [](unsigned long long ns) { return ns / 1000; };
+
+  addCommentSignForSZS(out);
+  out << "{\"inference_rules\":[";
+  bool first = true;
+  for (unsigned i = 0; i < inferenceRuleCosts.size(); i++) {
+    InferenceRuleCost& c = inferenceRuleCosts[i];
+    if (!c.generated && !c.time) {
+      continue;
+    }
+    out << (first ? "" : ",")
+        << "{\"rule\":\"" << ruleName(static_cast<InferenceRule>(i)) << "\""
+        << ",\"generated\":" << c.generated
+        << ",\"retained\":" << c.retained
+        << ",\"activated\":" << c.activated
+        << ",\"time_us\":" << us(c.time) << "}";
+    first = false;
+  }
+  out << "],\"unattributed_time_us\":{"
+      << "\"forward_simplification\":" << us(unattributedForwardSimplificationTime)
+      << ",\"backward_simplification\":" << us(unattributedBackwardSimplificationTime)
+      << ",\"generating_inference\":" << us(unattributedGeneratingInferenceTime)
+      << "}}" << endl;
+}
+
 void Statistics::explainRefutationNotFound(ostream& out)
 {
   // should be a one-liner for each case!
@@ -339,6 +389,12 @@ void Statistics::print(ostream& out)
   COND_OUT("Evaluation count",         evaluationCnt);
   COND_OUT("Evaluation results greater than premise", evaluationGreater);
   COND_OUT("Evaluation results incomparable to premise", evaluationIncomp);
+  if (arithmeticMemoHits + arithmeticMemoMisses) {
+    addCommentSignForSZS(out);
+    out << "Arithmetic memo hit rate: " << arithmeticMemoHits * 100 / (arithmeticMemoHits + arithmeticMemoMisses) << "%" << endl;
+  }
+  COND_OUT("Arithmetic memo evictions", arithmeticMemoEvictions);
+  COND_OUT("Ground literals evaluated in batch", batchEvaluatedLiterals);
   COND_OUT("Logicial proxy rewrites", proxyEliminations);
   COND_OUT("Boolean simplifications", booleanSimps)
   //COND_OUT("Interpreted simplifications", interpretedSimplifications);
@@ -386,6 +442,8 @@ void Statistics::print(ostream& out)
   COND_OUT("TheoryInstSimpTautologies",theoryInstSimpTautologies);
   COND_OUT("TheoryInstSimpLostSolution",theoryInstSimpLostSolution);
   COND_OUT("TheoryInstSimpEmptySubstitutions",theoryInstSimpEmptySubstitution);
+  COND_OUT("Z3TranslationsReused",z3TranslationReuse);
+  COND_OUT("Z3CacheFlushes",z3CacheFlushes);
   COND_OUT("MaxInductionDepth",maxInductionDepth);
   COND_OUT("StructuralInduction",structInduction);
   COND_OUT("StructuralInductionInProof",structInductionInProof);
@@ -411,6 +469,7 @@ void Statistics::print(ostream& out)
   COND_OUT("InductionApplicationsInProof",inductionApplicationInProof);
   COND_OUT("GeneralizedInductionApplications",generalizedInductionApplication);
   COND_OUT("GeneralizedInductionApplicationsInProof",generalizedInductionApplicationInProof);
+  COND_OUT("ReusedInductionFormulas",inductionFormulaReuse);
   COND_OUT("Argument congruence", argumentCongruence);
   COND_OUT("Negative extensionality", negativeExtensionality);
   COND_OUT("Primitive substitutions", primitiveInstantiations);
@@ -462,6 +521,9 @@ void Statistics::print(ostream& out)
   }
 
   COND_OUT("Memory used [KB]", Allocator::getUsedMemory()/1024);
+  if (Allocator::hugePages()) {
+    Allocator::printHugePageStatistics(out);
+  }
 
   addCommentSignForSZS(out);
   out << "Time elapsed: ";
@@ -486,10 +548,18 @@ void Statistics::print(ostream& out)
 #undef COND_OUT
   } // if (env.options->statistics()!=Options::Statistics::NONE)
 
+  if (env.options && env.options->inferenceRuleStatistics()) {
+    printInferenceRuleCosts(out);
+  }
+  if (env.options && env.options->hardwareCounters()) {
+    Timer::printHardwareCounters(out);
+  }
+
 #if VTIME_PROFILING
   if (env.options && env.options->timeStatistics()) {
     TimeTrace::instance().printPretty(out);
   }
+  TimeTrace::instance().outputToFile();
 #endif // VTIME_PROFILING
 }
 
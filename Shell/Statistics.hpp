@@ -21,6 +21,7 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DArray.hpp"
 #include "Lib/ScopedPtr.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -30,6 +31,7 @@ extern const char* VERSION_STRING;
 
 namespace Kernel {
   class Unit;
+  enum class InferenceRule : unsigned char;
 }
 
 namespace Shell {
@@ -51,6 +53,20 @@ public:
   void print(std::ostream& out);
   void explainRefutationNotFound(std::ostream& out);
 
+  /** Costs of one inference rule, collected with --inference_rule_statistics */
+  struct InferenceRuleCost {
+    /** clauses concluded by the rule that reached the unprocessed queue */
+    unsigned generated;
+    /** of those, the clauses that survived forward simplification and became passive */
+    unsigned retained;
+    /** of those, the clauses that were activated */
+    unsigned activated;
+    /** time spent deriving the conclusions of the rule, in nanoseconds */
+    unsigned long long time;
+  };
+  InferenceRuleCost& inferenceRuleCost(InferenceRule rule);
+  void printInferenceRuleCosts(std::ostream& out);
+
   // Input
   /** number of input clauses */
   unsigned inputClauses;
@@ -124,6 +140,10 @@ public:
   unsigned theoryInstSimpLostSolution;
   /** number of theoryInstSimp application where an empty substitution was applied */
   unsigned theoryInstSimpEmptySubstitution;
+  /** number of ground literals whose Z3 translation was taken from the cache */
+  unsigned long z3TranslationReuse;
+  /** number of times a cache of Z3 expressions was emptied for growing too large */
+  unsigned z3CacheFlushes;
   /** number of induction applications **/
   unsigned maxInductionDepth;
   unsigned structInduction;
@@ -150,6 +170,8 @@ public:
   unsigned inductionApplicationInProof;
   unsigned generalizedInductionApplication;
   unsigned generalizedInductionApplicationInProof;
+  /** number of induction contexts whose clausified induction formulas were already in the index */
+  unsigned inductionFormulaReuse;
   /** number of argument congruences */
   unsigned argumentCongruence;
   unsigned narrow;
@@ -213,6 +235,14 @@ public:
   unsigned evaluationGreater;
   /** number of simplifications by PolynomialNormalizer */
   unsigned evaluationCnt;
+  /** lookups in the arithmetic normalisation memos that found a cached result */
+  unsigned long arithmeticMemoHits;
+  /** lookups in the arithmetic normalisation memos that had to evaluate */
+  unsigned long arithmeticMemoMisses;
+  /** entries evicted from the arithmetic normalisation memos */
+  unsigned long arithmeticMemoEvictions;
+  /** ground arithmetic literals evaluated by GroundArithmeticEvaluator */
+  unsigned long batchEvaluatedLiterals;
 
   /** number of (proper) inner rewrites */
   unsigned innerRewrites;
@@ -258,6 +288,14 @@ public:
 
   unsigned inferencesSkippedDueToColors;
 
+  /** costs indexed by the number of the inference rule */
+  Lib::DArray<InferenceRuleCost> inferenceRuleCosts;
+  /** nanoseconds spent in simplifications that concluded no clause, i.e. deletions and failed attempts */
+  unsigned long long unattributedForwardSimplificationTime;
+  unsigned long long unattributedBackwardSimplificationTime;
+  /** nanoseconds spent in generating inferences after their last conclusion */
+  unsigned long long unattributedGeneratingInferenceTime;
+
   /** passive clauses at the end of the saturation algorithm run */
   unsigned finalPassiveClauses;
   /** active clauses at the end of the saturation algorithm run */
@@ -44,11 +44,11 @@ public:
   TheoryFinder(const UnitList*,Property* property);
   ~TheoryFinder();
   int search();
+  bool matchAll(const Unit* unit);
   static bool matchCode(const void* obj,const unsigned char* code);
   static bool matchKnownExtensionality(const Clause*);
 
 private:
-  bool matchAll(const Unit* unit);
   bool matchAll(const Clause* clause);
   bool matchAll(const Formula* formula);
   bool matchAll(const Literal* literal);
@@ -96,3 +96,27 @@ TEST_FUN(example_02__compute_size) {
 
   ASS_EQ(size, 6)
 }
+
+TEST_FUN(bounded_memo__evicts_unreferenced_entries) {
+  unsigned long hits = 0;
+  unsigned long misses = 0;
+  unsigned long evictions = 0;
+  Memo::Bounded<unsigned, unsigned> memo(4, hits, misses, evictions);
+  auto square = [&](unsigned i) { return memo.getOrInit(i, [&]() { return i * i; }); };
+
+  square(1); square(2); square(3); square(4);
+  ASS_EQ(misses, 4)
+
+  /* 1 and 2 are referenced, so they survive the sweep triggered by inserting 5 */
+  ASS_EQ(square(1), 1)
+  ASS_EQ(square(2), 4)
+  ASS_EQ(hits, 2)
+  ASS_EQ(square(5), 25)
+  ASS_EQ(evictions, 2)
+
+  ASS(memo.get(1).isSome())
+  ASS(memo.get(2).isSome())
+  ASS(memo.get(3).isNone())
+  ASS(memo.get(4).isNone())
+  ASS(memo.get(5).isSome())
+}
@@ -0,0 +1,54 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+
+#include "Kernel/GroundArithmeticEvaluator.hpp"
+
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+
+using namespace Kernel;
+using namespace Test;
+
+TEST_FUN(batch_int) {
+  NUMBER_SUGAR(Int)
+  DECL_DEFAULT_VARS
+  DECL_CONST(a, Int)
+
+  GroundArithmeticEvaluator batch;
+  ASS(batch.add(num(3) * 4 + -num(2) == num(10)))
+  ASS(batch.add(num(2147483647) + 1 > num(2147483647)))
+  ASS(!batch.add(a < num(3)))
+  ASS(!batch.add(x < num(3)))
+  ASS(batch.add(~(num(7) <= num(5))))
+  ASS(batch.add(num(7) <= num(5)))
+  ASS_EQ(batch.size(), 4)
+
+  Stack<bool> results;
+  batch.evaluate(results);
+  ASS_EQ(results.size(), 4)
+  ASS(results[0])
+  ASS(results[1])
+  ASS(results[2])
+  ASS(!results[3])
+}
+
+TEST_FUN(batch_real) {
+  NUMBER_SUGAR(Real)
+
+  GroundArithmeticEvaluator batch;
+  ASS(batch.add(frac(1,2) + frac(1,3) == frac(5,6)))
+  ASS(!batch.add(num(1) / num(2) == frac(1,2)))
+  ASS(batch.add(num(2) * frac(1,3) >= num(1)))
+
+  Stack<bool> results;
+  batch.evaluate(results);
+  ASS(results[0])
+  ASS(!results[1])
+}
@@ -9,11 +9,13 @@
  */
 #include <iostream>
 #include "Lib/List.hpp"
+#include "Kernel/Theory.hpp"
 
 #include "Test/UnitTesting.hpp"
 
 using namespace std;
 using namespace Lib;
+using namespace Kernel;
 
 TEST_FUN(list_1)
 {
@@ -29,3 +31,41 @@ TEST_FUN(list_1)
   ASS_EQ(lst->head(), 0);
   ASS_ALLOC_TYPE(lst, "List");
 }
+
+TEST_FUN(overflow_to_big_integer)
+{
+  IntegerConstantType max(std::numeric_limits<int>::max());
+  IntegerConstantType big = max + 1;
+  ASS(!big.isSmall())
+  ASS_EQ(big.toString(), "2147483648")
+  ASS_EQ(big - 1, max)
+  ASS((big - 1).isSmall())
+  ASS(big > max)
+  ASS_EQ(-IntegerConstantType(std::numeric_limits<int>::min()), big)
+
+  IntegerConstantType square = big * big;
+  ASS_EQ(square.toString(), "4611686018427387904")
+  ASS_EQ(square, IntegerConstantType("4611686018427387904"))
+  ASS_EQ(square.quotientT(big), big)
+  ASS_EQ(square.log2Abs(), 62)
+}
+
+TEST_FUN(big_integer_division)
+{
+  IntegerConstantType n("-100000000000000000000007");
+  IntegerConstantType d("1000000000000");
+  ASS_EQ(n.quotientT(d).toString(), "-100000000000")
+  ASS_EQ(n.remainderT(d), IntegerConstantType(-7))
+  ASS_EQ(n.quotientF(d).toString(), "-100000000001")
+  ASS_EQ(n.remainderE(d).toString(), "999999999993")
+  ASS(d.divides(n - IntegerConstantType(-7)))
+  ASS_EQ(IntegerConstantType::gcd(n - IntegerConstantType(-7), d * IntegerConstantType(3)), d)
+}
+
+TEST_FUN(big_rationals_are_normalised)
+{
+  IntegerConstantType big("6000000000000");
+  RationalConstantType r(big, big * IntegerConstantType(-4));
+  ASS_EQ(r.numerator(), IntegerConstantType(-1))
+  ASS_EQ(r.denominator(), IntegerConstantType(4))
+}
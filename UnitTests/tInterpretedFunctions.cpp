@@ -222,6 +222,21 @@ void check_eval(Lit orig_, Lit expected_) {
   NUM_TEST(Rat , name, formula, expected)                                                                     \
   NUM_TEST(Real, name, formula, expected)                                                                     \
 
+/** A numeral of the number sort of the current test that need not fit into an int. */
+TermSugar bigNum(const char* digits, int den = 1)
+{
+  auto srt = num(0).sort();
+  auto n = IntegerConstantType(vstring(digits));
+  if (srt == IntTraits::sort()) {
+    ASS_EQ(den, 1)
+    return TermSugar(TermList(theory->representConstant(n)));
+  } else if (srt == RatTraits::sort()) {
+    return TermSugar(TermList(theory->representConstant(RationalConstantType(n, den))));
+  } else {
+    return TermSugar(TermList(theory->representConstant(RealConstantType(RationalConstantType(n, den)))));
+  }
+}
+
 /////////////////////////////////////////////// Test cases ///////////////////////////////////////////////////////
 
 ALL_NUMBERS_TEST(partial_eval_add_1,
@@ -584,36 +599,38 @@ INT_TEST(div_zero_2,
     r(remainderE(num(7), 0),     11     )
     )
 
+// the following used to overflow machine integers,
+// which are now extended to arbitrary precision instead
+
 ALL_NUMBERS_TEST(eval_overflow_1,
     p(num(1661992960) + 1661992960),
-    evaluationFail
+    p(bigNum("3323985920"))
     )
 
 ALL_NUMBERS_TEST(eval_overflow_2,
     r(num(1661992960) + 1661992960, num(7) + 3),
-    r(num(1661992960) + 1661992960, 10)
+    r(bigNum("3323985920"), 10)
     )
 
 ALL_NUMBERS_TEST(eval_overflow_3,
     r(num(1661992960) * 1661992960, num(7) + 3),
-    r(num(1661992960) * 1661992960, 10)
+    r(bigNum("2762220599089561600"), 10)
     )
 
 ALL_NUMBERS_TEST(eval_overflow_4,
     p(-1 * num(std::numeric_limits<int>::min())),
-    // p(-num(std::numeric_limits<int>::min()))
-    evaluationFail
+    p(bigNum("2147483648"))
     )
 
 ALL_NUMBERS_TEST(eval_overflow_5,
     p(std::numeric_limits<int>::min() * num(std::numeric_limits<int>::min() + 1) * std::numeric_limits<int>::min()),
-    evaluationFail
+    p(bigNum("-9903520309671356180765605888"))
     )
 
 FRACTIONAL_TEST(eval_overflow_6,
     // p($sum(0.0555556,-1260453006.0)),
     p(frac(5,90) + num(-1260453006)),
-    evaluationFail
+    p(bigNum("-22688154107", 18))
     )
 
 FRACTIONAL_TEST(eval_overflow_7,
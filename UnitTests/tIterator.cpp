@@ -100,3 +100,19 @@ TEST_FUN(testFlatMap2) {
 }
 
 
+
+TEST_FUN(testInlineArrayIterator) {
+  auto in  = Stack<int>{ 0, 1, 2, };
+  auto out = Stack<int>{ 1, 2, 2, };
+
+  // between zero and two elements per input, without going through VirtualIterator
+  ASS_EQ(iterTraits(in.iterFifo())
+      .flatMap([](int i) {
+          InlineArrayIterator<int, 2> it;
+          for (int j = 0; j < i; j++) {
+            it.push(i);
+          }
+          return it;
+      })
+      .template collect<Stack>(), out)
+}
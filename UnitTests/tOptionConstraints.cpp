@@ -8,6 +8,7 @@
  * and in the source directory
  */
 
+#include "Lib/Environment.hpp"
 #include "Lib/VString.hpp"
 #include "Shell/Options.hpp"
 
@@ -69,3 +70,12 @@ TEST_FUN(urr)
     ASS(!testGlobal(o));
   } 
 }
+
+TEST_FUN(unknown_option_warning)
+{
+  // warning about an unknown option in a strategy must not keep the output locked
+  Options o;
+  o.setIgnoreMissing(Options::IgnoreMissing::WARN);
+  o.readFromEncodedOptions("dis+10_1_nosuchoption=on_10");
+  ASS(!env.haveOutput());
+}
@@ -0,0 +1,40 @@
+(declare-sort U 0)
+(declare-fun f (U U) U)
+(declare-fun a () U)
+(declare-fun g (U) U)
+(assert
+(let ((x1 (f a a)))
+(let ((x2 (f x1 x1)))
+(let ((x3 (f x2 x2)))
+(let ((x4 (f x3 x3)))
+(let ((x5 (f x4 x4)))
+(let ((x6 (f x5 x5)))
+(let ((x7 (f x6 x6)))
+(let ((x8 (f x7 x7)))
+(let ((x9 (f x8 x8)))
+(let ((x10 (f x9 x9)))
+(let ((x11 (f x10 x10)))
+(let ((x12 (f x11 x11)))
+(let ((x13 (f x12 x12)))
+(let ((x14 (f x13 x13)))
+(let ((x15 (f x14 x14)))
+(let ((x16 (f x15 x15)))
+(let ((x17 (f x16 x16)))
+(let ((x18 (f x17 x17)))
+(let ((x19 (f x18 x18)))
+(let ((x20 (f x19 x19)))
+(let ((x21 (f x20 x20)))
+(let ((x22 (f x21 x21)))
+(let ((x23 (f x22 x22)))
+(let ((x24 (f x23 x23)))
+(let ((x25 (f x24 x24)))
+(let ((x26 (f x25 x25)))
+(let ((x27 (f x26 x26)))
+(let ((x28 (f x27 x27)))
+(let ((x29 (f x28 x28)))
+(let ((x30 (f x29 x29)))
+(let ((x31 (f x30 x30)))
+(let ((x32 (f x31 x31)))
+  (not (= (g x32) x32)))))))))))))))))))))))))))))))))))
+(assert (forall ((x U)) (= (g x) x)))
+(check-sat)
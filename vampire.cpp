@@ -659,7 +659,9 @@ int main(int argc, char* argv[])
     Shell::CommandLine cl(argc, argv);
     cl.interpret(*env.options);
 #if VTIME_PROFILING
-    TimeTrace::instance().setEnabled(env.options->timeStatistics());
+    TimeTrace::instance().setEnabled(env.options->timeStatistics() || !env.options->timeTraceFile().empty());
+    TimeTrace::instance().setSampling(env.options->timeTraceSampling());
+    TimeTrace::instance().initOutputFile();
 #endif
 
     // If any of these options are set then we just need to output and exit
@@ -675,6 +677,8 @@ int main(int argc, char* argv[])
     }
 
     Allocator::setMemoryLimit(env.options->memoryLimit() * 1048576ul);
+    Allocator::setHugePages(env.options->hugePages());
+    Timer::resetHardwareCounters();
     Lib::Random::setSeed(env.options->randomSeed());
 
     switch (env.options->mode())